@@ -0,0 +1,115 @@
+import os
+import json
+import math
+import argparse
+from PIL import Image
+
+
+def trim(img):
+    # Bounding box of the opaque pixels, a fully transparent frame keeps one pixel
+    bbox = img.getchannel('A').getbbox() or (0, 0, 1, 1)
+    return img.crop(bbox), bbox[0], bbox[1]
+
+
+def shelf_pack(sizes):
+    # Tallest first, left to right, a new shelf when the row is full.
+    # Width is a multiple of 8 so the 1-bit rows of the atlas stay byte aligned.
+    if not sizes:
+        raise ValueError('no frames to pack')
+    area = sum(w * h for w, h in sizes)
+    width = max(max(w for w, _ in sizes), int(math.ceil(math.sqrt(area))))
+    width = (width + 7) // 8 * 8
+
+    positions = [None] * len(sizes)
+    x = y = shelf_height = 0
+    for index in sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0])):
+        w, h = sizes[index]
+        if x + w > width:
+            x = 0
+            y += shelf_height
+            shelf_height = 0
+        positions[index] = (x, y)
+        x += w
+        shelf_height = max(shelf_height, h)
+    return positions, width, y + shelf_height
+
+
+def collect_clips(input_folder):
+    # Every folder with frames is a clip, named by its path under the input folder
+    clips = []
+    for folder, _, files in sorted(os.walk(input_folder)):
+        frames = sorted(f for f in files if f.endswith('.png'))
+        if frames:
+            name = os.path.relpath(folder, input_folder).replace(os.sep, '/')
+            clips.append((name, [os.path.join(folder, f) for f in frames]))
+    return clips
+
+
+def collect_sprites(input_folder, root, output):
+    # Every image is a one frame clip, named by its path in the game without extension.
+    # A previous atlas written inside the input folder is skipped.
+    clips = []
+    for folder, _, files in sorted(os.walk(input_folder)):
+        for f in sorted(files):
+            path = os.path.join(folder, f)
+            if f.endswith('.png') and os.path.abspath(path) != os.path.abspath(output + '.png'):
+                name = os.path.splitext(os.path.relpath(path, root))[0].replace(os.sep, '/')
+                clips.append((name, [path]))
+    return clips
+
+
+def pack_atlas(clips, output):
+    frames = []   # (clip, image index, offset x, offset y, source width, source height)
+    images = []   # unique trimmed images
+    seen = {}
+    for name, paths in clips:
+        for path in paths:
+            img = Image.open(path).convert('RGBA')
+            trimmed, ox, oy = trim(img)
+            # Identical frames share the same rectangle
+            key = (trimmed.size, trimmed.tobytes())
+            if key not in seen:
+                seen[key] = len(images)
+                images.append(trimmed)
+            frames.append((name, seen[key], ox, oy, img.width, img.height))
+
+    positions, width, height = shelf_pack([img.size for img in images])
+    atlas = Image.new('RGBA', (width, height), (0, 0, 0, 0))
+    for img, position in zip(images, positions):
+        atlas.paste(img, position)
+    atlas.save(output + '.png')
+
+    metadata = []
+    for name, index, ox, oy, sw, sh in frames:
+        x, y = positions[index]
+        w, h = images[index].size
+        metadata.append({'clip': name, 'x': x, 'y': y, 'w': w, 'h': h, 'ox': ox, 'oy': oy, 'sw': sw, 'sh': sh})
+    with open(output + '.json', 'w') as f:
+        json.dump(metadata, f, indent='\t')
+
+    source_pixels = sum(sw * sh for *_, sw, sh in frames)
+    print(f'{output}: {len(frames)} frames, {len(images)} unique, {width}x{height} '
+          f'({width * height} pixels, {source_pixels} before packing)')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack animation frames or sprites into one atlas image and a JSON frame list')
+    parser.add_argument('input', help='Input folder path')
+    parser.add_argument('output', help='Output path without extension, gets .png and .json')
+    parser.add_argument('--sprites', metavar='ROOT', help='Pack every image as its own sprite, named by its path under ROOT')
+
+    args = parser.parse_args()
+    if args.sprites:
+        clips = collect_sprites(args.input, args.sprites, args.output)
+    else:
+        clips = collect_clips(args.input)
+    if not clips:
+        parser.error(f'no .png frames found in {args.input}')
+    pack_atlas(clips, args.output)
+
+if __name__ == '__main__':
+    main()
+
+
+# python3 pack-atlas.py ../Source/images/player/animations ../Source/images/player/atlas
+# python3 pack-atlas.py ../Source/images/monsters ../Source/images/monsters/atlas --sprites ../Source
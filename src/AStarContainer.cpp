@@ -18,58 +18,135 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 
 #include "AStarContainer.h"
 #include <cstring>
-#include <cfloat>
+#include <climits>
+#include <algorithm>
+
+namespace {
+
+// generation 0 is never used by a search, so a freshly allocated stamp array reads as empty
+unsigned int nextGeneration(unsigned int generation, AStar_Stamps& stamps) {
+	generation++;
+	if (generation == 0) {
+		// the counter wrapped around, old stamps could be mistaken for the current search
+		std::fill(stamps.begin(), stamps.end(), 0);
+		generation = 1;
+	}
+	return generation;
+}
+
+}
+
+AStarNodePool::AStarNodePool(unsigned int _map_width, unsigned int _map_height)
+	: map_width(0)
+	, map_height(0)
+{
+	Resize(_map_width, _map_height);
+}
+
+bool AStarNodePool::Resize(unsigned int _map_width, unsigned int _map_height) {
+	map_width = _map_width;
+	map_height = _map_height;
+
+	size_t tiles = static_cast<size_t>(map_width) * map_height;
+	if (tiles <= nodes.size())
+		return false;
+
+	nodes.resize(tiles);
+	return true;
+}
+
+AStarNode* AStarNodePool::Get(const pdcpp::Point<int>& pos) {
+	return &nodes[pos.y * map_width + pos.x];
+}
 
 AStarContainer::AStarContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit)
 	: size(0)
-	, node_limit(_node_limit)
-	, map_width(_map_width)
-	, map_height(_map_height)
+	, node_limit(0)
+	, map_width(0)
+	, map_height(0)
+	, generation(1)
 {
-	nodes.resize(node_limit, NULL);
-
-	//initialise the map array. A -1 value will mean there is no node at that position
-	map_pos.resize(map_width);
-	for (unsigned i=0; i<map_width; ++i) {
-		map_pos[i].resize(map_height, -1);
-	}
+	Resize(_map_width, _map_height);
+	Clear(_node_limit);
 }
 
 AStarContainer::~AStarContainer() {
-	for(unsigned int i=0; i<size; i++)
-		delete nodes[i];
-	nodes.clear();
+	// nodes are owned by the AStarNodePool
+}
+
+bool AStarContainer::Resize(unsigned int _map_width, unsigned int _map_height) {
+	map_width = _map_width;
+	map_height = _map_height;
+	size = 0;
+
+	size_t tiles = static_cast<size_t>(map_width) * map_height;
+	if (tiles <= map_pos.size())
+		return false;
+
+	nodes.resize(tiles, NULL);
+	map_pos.resize(tiles, -1);
+	map_stamp.resize(tiles, 0);
+	return true;
+}
+
+void AStarContainer::Clear(unsigned int _node_limit) {
+	size = 0;
+	node_limit = std::min(_node_limit, map_width * map_height);
+	generation = nextGeneration(generation, map_stamp);
 }
 
 int AStarContainer::GetSize() {
 	return size;
 }
 
-void AStarContainer::Add(AStarNode* node) {
-	if (size >= node_limit) return;
+void AStarContainer::place(unsigned int index, AStarNode* node) {
+	nodes[index] = node;
+	const int tile = node->getY() * map_width + node->getX();
+	map_pos[tile] = static_cast<int>(index);
+	map_stamp[tile] = generation;
+}
 
-	//add the new node at the end and update its index
-	nodes[size] = node;
-	map_pos[node->getX()][node->getY()] = static_cast<short>(size);
-
-	//reorder the heap based on f ordering, staring with thenewly added node and working up the tree from there
-	int m = size;
-
-	AStarNode* temp = NULL;
-	while(m != 0) {
-		//if the current nodes f value is shorter than its parent, they need to be swapped
-		if(nodes[m]->getFinalCost() <= nodes[m/2]->getFinalCost()) {
-			temp = nodes[m/2];
-			nodes[m/2] = nodes[m];
-			map_pos[nodes[m/2]->getX()][nodes[m/2]->getY()] = static_cast<short>(m/2);
-			nodes[m] = temp;
-			map_pos[nodes[m]->getX()][nodes[m]->getY()] = static_cast<short>(m);
-			m=m/2;
+void AStarContainer::siftUp(unsigned int m) {
+	//working up the tree: if the current nodes f value is shorter than its parent, they need to be swapped
+	AStarNode* node = nodes[m];
+	while (m != 0) {
+		unsigned int parent = (m - 1) / 2;
+		if (node->getFinalCost() <= nodes[parent]->getFinalCost()) {
+			place(m, nodes[parent]);
+			m = parent;
 		}
 		else
 			break;
 	}
+	place(m, node);
+}
+
+void AStarContainer::siftDown(unsigned int m) {
+	//working down the tree: swap with the lowest child while the parent's f is greater
+	AStarNode* node = nodes[m];
+	while (true) {
+		unsigned int child = 2 * m + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && nodes[child + 1]->getFinalCost() < nodes[child]->getFinalCost())
+			child++;
+		if (nodes[child]->getFinalCost() < node->getFinalCost()) {
+			place(m, nodes[child]);
+			m = child;
+		}
+		else
+			break;
+	}
+	place(m, node);
+}
+
+void AStarContainer::Add(AStarNode* node) {
+	if (size >= node_limit) return;
+
+	//add the new node at the end and reorder the heap based on f ordering, starting with the newly added node
+	nodes[size] = node;
 	size++;
+	siftUp(size - 1);
 }
 
 AStarNode* AStarContainer::GetShortestF() {
@@ -77,104 +154,202 @@ AStarNode* AStarContainer::GetShortestF() {
 }
 
 void AStarContainer::Remove(AStarNode* node) {
+	const int tile = node->getY() * map_width + node->getX();
+	unsigned int heap_index = static_cast<unsigned int>(map_pos[tile]);
 
-	unsigned int heap_indexv = map_pos[node->getX()][node->getY()] + 1;
-
-	//swap the last node in the list with the node being deleted
-	nodes[heap_indexv-1] = nodes[size-1];
-	map_pos[nodes[heap_indexv-1]->getX()][nodes[heap_indexv-1]->getY()] = static_cast<short>(heap_indexv-1);
+	//remove the node from the map pos index
+	map_stamp[tile] = 0;
 
 	size--;
-
-	if(size == 0) {
-		map_pos[node->getX()][node->getY()] = -1;
+	if (heap_index == size)
 		return;
-	}
-
-	// reorder the heap to maintain the f ordering, starting at the node which replaced the deleted node, and working down the tree
-
-	while(true) {
-		//start at the node which dropped down the tree on the previous iteration
-		unsigned int heap_indexu = heap_indexv;
-		if(2*heap_indexu+1 <= size) { //if both children exist
-			//Select the lowest of the two children.
-			if(nodes[heap_indexu-1]->getFinalCost() >= nodes[2*heap_indexu-1]->getFinalCost()) heap_indexv = 2*heap_indexu;
-			if(nodes[heap_indexv-1]->getFinalCost() >= nodes[2*heap_indexu]->getFinalCost()) heap_indexv = 2*heap_indexu+1;
-		}
-		else if (2*heap_indexu <= size) { //if only child #1 exists
-			//Check if the F cost is greater than the child
-			if(nodes[heap_indexu-1]->getFinalCost() >= nodes[2*heap_indexu-1]->getFinalCost()) heap_indexv = 2*heap_indexu;
-		}
-
-		if(heap_indexu != heap_indexv) { //If parent's F > one or both of its children, swap them
-			AStarNode* temp = nodes[heap_indexu-1];
-			nodes[heap_indexu-1] = nodes[heap_indexv-1];
-			map_pos[nodes[heap_indexu-1]->getX()][nodes[heap_indexu-1]->getY()] = static_cast<short>(heap_indexu-1);
-			nodes[heap_indexv-1] = temp;
-			map_pos[nodes[heap_indexv-1]->getX()][nodes[heap_indexv-1]->getY()] = static_cast<short>(heap_indexv-1);
-		}
-		else {
-			break;//if item <= both children, exit loop
-		}
-	}//Repeat forever
 
-	//remove the node from the map pos index
-	map_pos[node->getX()][node->getY()] = -1;
+	//move the last node in the list into the hole and restore the f ordering from there
+	nodes[heap_index] = nodes[size];
+	if (heap_index > 0 && nodes[heap_index]->getFinalCost() <= nodes[(heap_index - 1) / 2]->getFinalCost())
+		siftUp(heap_index);
+	else
+		siftDown(heap_index);
 }
 
 bool AStarContainer::exists(const pdcpp::Point<int>& pos) {
-	return map_pos[pos.x][pos.y] != -1;
+	return map_stamp[pos.y * map_width + pos.x] == generation;
 }
 
 AStarNode* AStarContainer::Get(int x, int y) {
-	return nodes[map_pos[x][y]];
+	return nodes[map_pos[y * map_width + x]];
 }
 
 bool AStarContainer::IsEmpty() {
 	return size == 0;
 }
 
-void AStarContainer::UpdateParent(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent_pos, float score) {
+void AStarContainer::UpdateParent(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent_pos, unsigned int score) {
 	Get(pos.x, pos.y)->setParent(parent_pos);
 	Get(pos.x, pos.y)->setActualCost(score);
 
-	//reorder the heap based on the new f value of this node. starting at the updated node and working up the tree
-	int m = map_pos[pos.x][pos.y];
-	AStarNode* temp = NULL;
-	while(m != 0) {
-		//if the current node has a lower f value than its parent in the heap, swap them
-		if(nodes[m]->getFinalCost() <= nodes[m/2]->getFinalCost()) {
-			temp = nodes[m/2];
-			nodes[m/2] = nodes[m];
-			map_pos[nodes[m/2]->getX()][nodes[m/2]->getY()] = static_cast<short>(m/2);
-			nodes[m] = temp;
-			map_pos[nodes[m]->getX()][nodes[m]->getY()] = static_cast<short>(m);
-			m=m/2;
-		}
-		else
-			break;
-	}
+	//the f value of this node can only decrease, so the node can only move up the tree
+	siftUp(static_cast<unsigned int>(map_pos[pos.y * map_width + pos.x]));
 }
 
-AStarCloseContainer::AStarCloseContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit)
+AStarBucketContainer::AStarBucketContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit)
 	: size(0)
-	, node_limit(_node_limit)
-	, map_width(_map_width)
-	, map_height(_map_height)
+	, node_limit(0)
+	, map_width(0)
+	, map_height(0)
+	, generation(1)
+	, lowest_bucket(0)
 {
-	nodes.resize(node_limit, NULL);
+	Resize(_map_width, _map_height);
+	Clear(_node_limit);
+}
 
-	//initialise the map array. A -1 value will mean there is no node at that position
-	map_pos.resize(map_width);
-	for (unsigned i=0; i<map_width; ++i) {
-		map_pos[i].resize(map_height, -1);
+bool AStarBucketContainer::Resize(unsigned int _map_width, unsigned int _map_height) {
+	map_width = _map_width;
+	map_height = _map_height;
+	size = 0;
+
+	size_t tiles = static_cast<size_t>(map_width) * map_height;
+	if (tiles <= map_stamp.size())
+		return false;
+
+	nodes.resize(tiles, NULL);
+	next_in_bucket.resize(tiles, -1);
+	prev_in_bucket.resize(tiles, -1);
+	node_bucket.resize(tiles, 0);
+	map_stamp.resize(tiles, 0);
+	return true;
+}
+
+void AStarBucketContainer::Clear(unsigned int _node_limit) {
+	size = 0;
+	node_limit = std::min(_node_limit, map_width * map_height);
+	lowest_bucket = UINT_MAX;
+	generation = nextGeneration(generation, map_stamp);
+	if (generation == 1) {
+		// the stamps were just wiped for a wrap around, the buckets share the generation
+		std::fill(bucket_stamp.begin(), bucket_stamp.end(), 0);
 	}
 }
 
+int AStarBucketContainer::GetSize() {
+	return size;
+}
+
+void AStarBucketContainer::link(int tile, unsigned int bucket) {
+	if (bucket >= bucket_head.size()) {
+		const size_t buckets = std::max(static_cast<size_t>(bucket) + 1, bucket_head.size() * 2);
+		bucket_head.resize(buckets, -1);
+		bucket_stamp.resize(buckets, 0);
+	}
+	if (bucket_stamp[bucket] != generation) {
+		bucket_stamp[bucket] = generation;
+		bucket_head[bucket] = -1;
+	}
+
+	const int head = bucket_head[bucket];
+	next_in_bucket[tile] = head;
+	prev_in_bucket[tile] = -1;
+	if (head >= 0)
+		prev_in_bucket[head] = tile;
+	bucket_head[bucket] = tile;
+	node_bucket[tile] = bucket;
+
+	if (bucket < lowest_bucket)
+		lowest_bucket = bucket;
+}
+
+void AStarBucketContainer::unlink(int tile) {
+	const int prev = prev_in_bucket[tile];
+	const int next = next_in_bucket[tile];
+	if (prev >= 0)
+		next_in_bucket[prev] = next;
+	else
+		bucket_head[node_bucket[tile]] = next;
+	if (next >= 0)
+		prev_in_bucket[next] = prev;
+}
+
+void AStarBucketContainer::Add(AStarNode* node) {
+	if (size >= node_limit) return;
+
+	const int tile = node->getY() * map_width + node->getX();
+	nodes[tile] = node;
+	map_stamp[tile] = generation;
+	link(tile, node->getFinalCost());
+	size++;
+}
+
+AStarNode* AStarBucketContainer::GetShortestF() {
+	while (bucket_stamp[lowest_bucket] != generation || bucket_head[lowest_bucket] < 0)
+		lowest_bucket++;
+	return nodes[bucket_head[lowest_bucket]];
+}
+
+void AStarBucketContainer::Remove(AStarNode* node) {
+	const int tile = node->getY() * map_width + node->getX();
+	unlink(tile);
+	map_stamp[tile] = 0;
+	size--;
+}
+
+bool AStarBucketContainer::exists(const pdcpp::Point<int>& pos) {
+	return map_stamp[pos.y * map_width + pos.x] == generation;
+}
+
+AStarNode* AStarBucketContainer::Get(int x, int y) {
+	return nodes[y * map_width + x];
+}
+
+bool AStarBucketContainer::IsEmpty() {
+	return size == 0;
+}
+
+void AStarBucketContainer::UpdateParent(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent_pos, unsigned int score) {
+	const int tile = pos.y * map_width + pos.x;
+	AStarNode* node = nodes[tile];
+	node->setParent(parent_pos);
+	node->setActualCost(score);
+
+	//move the node to the bucket of its new, lower, f value
+	unlink(tile);
+	link(tile, node->getFinalCost());
+}
+
+AStarCloseContainer::AStarCloseContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit)
+	: size(0)
+	, node_limit(0)
+	, map_width(0)
+	, map_height(0)
+	, generation(1)
+{
+	Resize(_map_width, _map_height);
+	Clear(_node_limit);
+}
+
 AStarCloseContainer::~AStarCloseContainer() {
-	for(unsigned int i=0; i<size; i++)
-		delete nodes[i];
-	nodes.clear();
+	// nodes are owned by the AStarNodePool
+}
+
+bool AStarCloseContainer::Resize(unsigned int _map_width, unsigned int _map_height) {
+	map_width = _map_width;
+	map_height = _map_height;
+	size = 0;
+
+	size_t tiles = static_cast<size_t>(map_width) * map_height;
+	if (tiles <= map_pos.size())
+		return false;
+
+	nodes.resize(tiles, NULL);
+	map_pos.resize(tiles, -1);
+	map_stamp.resize(tiles, 0);
+	return true;
+}
+
+void AStarCloseContainer::Clear(unsigned int _node_limit) {
+	size = 0;
+	node_limit = std::min(_node_limit, map_width * map_height);
+	generation = nextGeneration(generation, map_stamp);
 }
 
 int AStarCloseContainer::GetSize() {
@@ -184,22 +359,24 @@ int AStarCloseContainer::GetSize() {
 void AStarCloseContainer::Add(AStarNode* node) {
 	if (size >= node_limit) return;
 
+	const int tile = node->getY() * map_width + node->getX();
 	nodes[size] = node;
-	map_pos[node->getX()][node->getY()] = static_cast<short>(size);
+	map_pos[tile] = static_cast<int>(size);
+	map_stamp[tile] = generation;
 	size++;
 }
 
 bool AStarCloseContainer::Exists(const pdcpp::Point<int>& pos) {
-	return map_pos[pos.x][pos.y] != -1;
+	return map_stamp[pos.y * map_width + pos.x] == generation;
 }
 
 AStarNode* AStarCloseContainer::Get(int x, int y) {
-	return nodes[map_pos[x][y]];
+	return nodes[map_pos[y * map_width + x]];
 }
 
 AStarNode* AStarCloseContainer::GetShortestH() {
 	AStarNode *current = NULL;
-	float lowest_score = FLT_MAX;
+	unsigned int lowest_score = UINT_MAX;
 	for(unsigned int i = 0; i < size; i++) {
 		if(nodes[i]->getH() < lowest_score) {
 			lowest_score = nodes[i]->getH();
@@ -23,19 +23,49 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #include "AStarNode.h"
 #include "pdcpp/graphics/Point.h"
 
-typedef std::vector< std::vector<short> > AStar_Grid;
+/* Flat per-tile arrays indexed by (y * map_width + x), matching the row-major layout used by Area */
+typedef std::vector<int> AStar_Grid;
+typedef std::vector<unsigned int> AStar_Stamps;
+
+/* Backing storage for every node a search can touch.
+*  There is one slot per map tile, and a tile is never in the open and the closed list at the same time,
+*  so a search can hand out nodes without allocating. The pool is owned by MapCollision and reused between queries.
+*/
+class AStarNodePool {
+public:
+	AStarNodePool(unsigned int _map_width, unsigned int _map_height);
+	AStarNodePool(const AStarNodePool&) = delete;
+
+	// returns true if memory had to be (re)allocated
+	bool Resize(unsigned int _map_width, unsigned int _map_height);
+	//assumes that the position is within the bounds of the map
+	AStarNode* Get(const pdcpp::Point<int>& pos);
+
+private:
+	unsigned int map_width;
+	unsigned int map_height;
+	std::vector<AStarNode> nodes;
+};
 
 /* Designed to be used for the Open nodes.
 *  Unsuitable for Closed nodes but a close node conatiner is declared below
 *
+*  The container does not own its nodes, they live in an AStarNodePool.
+*  It is meant to be kept alive between searches: Clear() starts a new search in O(1) by bumping a generation stamp,
+*  so no memory is touched or allocated once the container has been sized for the map.
+*
 *  All code in the class assumes that the nodes and points provided are within the bounds of the map limits
 */
 class AStarContainer {
 public:
 	AStarContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit);
-	AStarContainer(const AStarContainer&); // copy constructor not yet implemented
+	AStarContainer(const AStarContainer&) = delete;
 
 	~AStarContainer();
+	// returns true if memory had to be (re)allocated
+	bool Resize(unsigned int _map_width, unsigned int _map_height);
+	// empties the container for a new search, the node limit is clamped to the map size
+	void Clear(unsigned int _node_limit);
 	int GetSize();
 	//assumes that the node is not already in the collection
 	void Add(AStarNode* node);
@@ -47,22 +77,23 @@ public:
 	//assumes that the node exists in the collection
 	AStarNode* Get(int x, int y);
 	bool IsEmpty();
-	void UpdateParent(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent_pos, float score);
+	void UpdateParent(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent_pos, unsigned int score);
 
 private:
 	unsigned int size;
 	unsigned int node_limit;
 	unsigned int map_width;
 	unsigned int map_height;
+	unsigned int generation;
 
 	/* This is an array of AStarNode pointers. This is the main data for this collection.
-	*  The size of the array is based on the node limit.
+	*  Its capacity is the number of map tiles, the node limit of the current search only bounds how much of it is used.
 	*
 	*  The nodes in this array are ordered based on their f value and the node with the lowest f value is always at position 0.
 	*  The ordering is not linear, so after positon 0, we cannot assume that position 1 has the second shortest f value.
 	*
 	*  The ordering is based on a binary heap structure.
-	*  Essentially, each node can have up to 2 child nodes and each child node must have a lower f value than its parent.
+	*  Essentially, each node can have up to 2 child nodes and each child node must have a higher f value than its parent.
 	*  This rule must be maintained whenever nodes are added or removed or their f value changes
 	*
 	*  The tree is represented by a 1 dimentional array where position 0 has children at position 1 and 2
@@ -75,14 +106,77 @@ private:
 	*/
 	std::vector<AStarNode*> nodes;
 
-	/* This is a 2d array of shorts ([map_width][map_height]) which acts as an index for the main node array.
-	*  Elements can be accessed using cartesian coordinates e.g. map_pos[x][y]
-	*  To access an AStarNode based on map position use: nodes[map_pos[x][y]]
+	/* This is a flat array of ints ([map_width*map_height]) which acts as an index for the main node array.
+	*  To access an AStarNode based on map position use: nodes[map_pos[y*map_width + x]]
 	*
-	*  The data in this array is initialised as -1, which indicates hat there is no corresponding node for that position
+	*  An entry is only meaningful when the matching map_stamp equals the current generation,
+	*  otherwise there is no corresponding node for that position.
 	*  This must be maintained when nodes are added, removed and re-ordered in the node array
 	*/
 	AStar_Grid map_pos;
+	AStar_Stamps map_stamp;
+
+	void siftUp(unsigned int m);
+	void siftDown(unsigned int m);
+	void place(unsigned int index, AStarNode* node);
+};
+
+/* Open list variant with one bucket per f value instead of a binary heap.
+*  The integer costs make f a small whole number, so adding a node and taking the cheapest one are O(1):
+*  the cursor to the lowest bucket only walks over buckets that became empty.
+*  Nodes with the same f come out last in first out.
+*
+*  Each bucket is a doubly linked list threaded through per-tile arrays, so nodes can be moved
+*  between buckets when UpdateParent lowers their cost. The bucket array grows with the highest f
+*  seen and is reused between searches, like the per-tile arrays.
+*
+*  It has the same interface as AStarContainer so MapCollision can search with either one.
+*/
+class AStarBucketContainer {
+public:
+	AStarBucketContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit);
+	AStarBucketContainer(const AStarBucketContainer&) = delete;
+
+	// returns true if memory had to be (re)allocated
+	bool Resize(unsigned int _map_width, unsigned int _map_height);
+	// empties the container for a new search, the node limit is clamped to the map size
+	void Clear(unsigned int _node_limit);
+	int GetSize();
+	//assumes that the node is not already in the collection
+	void Add(AStarNode* node);
+	//assumes that there is at least 1 node in the collection
+	AStarNode* GetShortestF();
+	//assumes that the node exists in the collection
+	void Remove(AStarNode* node);
+	bool exists(const pdcpp::Point<int>& pos);
+	//assumes that the node exists in the collection
+	AStarNode* Get(int x, int y);
+	bool IsEmpty();
+	void UpdateParent(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent_pos, unsigned int score);
+	// number of buckets allocated so far, it only changes when the bucket array grows
+	size_t GetBucketCapacity() const { return bucket_head.size(); }
+
+private:
+	unsigned int size;
+	unsigned int node_limit;
+	unsigned int map_width;
+	unsigned int map_height;
+	unsigned int generation;
+	unsigned int lowest_bucket; // no bucket below this one holds a node
+
+	// per tile, indexed by (y * map_width + x)
+	std::vector<AStarNode*> nodes;
+	AStar_Grid next_in_bucket;
+	AStar_Grid prev_in_bucket;
+	AStar_Stamps node_bucket; // the f value the node was filed under
+	AStar_Stamps map_stamp;
+
+	// per f value, a bucket is empty unless its stamp is the current generation
+	AStar_Grid bucket_head;
+	AStar_Stamps bucket_stamp;
+
+	void link(int tile, unsigned int bucket);
+	void unlink(int tile);
 };
 
 /* This class is used to store the closed list of a* nodes
@@ -91,9 +185,13 @@ private:
 class AStarCloseContainer {
 public:
 	AStarCloseContainer(unsigned int _map_width, unsigned int _map_height, unsigned int _node_limit);
-	AStarCloseContainer(const AStarCloseContainer&); // copy constructor not yet implemented
+	AStarCloseContainer(const AStarCloseContainer&) = delete;
 	~AStarCloseContainer();
 
+	// returns true if memory had to be (re)allocated
+	bool Resize(unsigned int _map_width, unsigned int _map_height);
+	// empties the container for a new search, the node limit is clamped to the map size
+	void Clear(unsigned int _node_limit);
 	int GetSize();
 	void Add(AStarNode* node);
 	bool Exists(const pdcpp::Point<int>& pos);
@@ -105,8 +203,10 @@ private:
 	unsigned int node_limit;
 	unsigned int map_width;
 	unsigned int map_height;
+	unsigned int generation;
 	std::vector<AStarNode*> nodes;
 	AStar_Grid map_pos;
+	AStar_Stamps map_stamp;
 
 };
 
@@ -44,7 +44,7 @@ int AStarNode::getY() const {
 	return y;
 }
 
-float AStarNode::getH() const {
+unsigned int AStarNode::getH() const {
 	return h;
 }
 
@@ -56,68 +56,75 @@ void AStarNode::setParent(const pdcpp::Point<int>& p) {
 	this->parent = p;
 }
 
-std::list<pdcpp::Point<int>> AStarNode::getNeighbours(int limitX, int limitY) const {
-    pdcpp::Point<int> toAdd =  {0,0};
-	std::list<pdcpp::Point<int>> res;
+void AStarNode::reset(const pdcpp::Point<int>& p) {
+	x = p.x;
+	y = p.y;
+	g = 0;
+	h = 0;
+	parent = p;
+}
+
+int AStarNode::getNeighbours(AStarNeighbours& res, int limitX, int limitY) const {
+	int count = 0;
 	if (x>node_stride && y>node_stride) {
-		toAdd.x = x-node_stride;
-		toAdd.y = y-node_stride;
-		res.push_back(toAdd);
+		res[count].x = x-node_stride;
+		res[count].y = y-node_stride;
+		count++;
 	}
 	if (x>node_stride && (limitY==0 || y<limitY-node_stride)) {
-		toAdd.x = x-node_stride;
-		toAdd.y = y+node_stride;
-		res.push_back(toAdd);
+		res[count].x = x-node_stride;
+		res[count].y = y+node_stride;
+		count++;
 	}
 	if (y>node_stride && (limitX==0 || x<limitX-node_stride)) {
-		toAdd.x = x+node_stride;
-		toAdd.y = y-node_stride;
-		res.push_back(toAdd);
+		res[count].x = x+node_stride;
+		res[count].y = y-node_stride;
+		count++;
 	}
 	if ((limitX==0 || x<limitX-node_stride) && (limitY==0 || y<limitY-node_stride)) {
-		toAdd.x = x+node_stride;
-		toAdd.y = y+node_stride;
-		res.push_back(toAdd);
+		res[count].x = x+node_stride;
+		res[count].y = y+node_stride;
+		count++;
 	}
 	if (x>node_stride) {
-		toAdd.x = x-node_stride;
-		toAdd.y = y;
-		res.push_back(toAdd);
+		res[count].x = x-node_stride;
+		res[count].y = y;
+		count++;
 	}
 	if (y>node_stride) {
-		toAdd.x = x;
-		toAdd.y = y-node_stride;
-		res.push_back(toAdd);
+		res[count].x = x;
+		res[count].y = y-node_stride;
+		count++;
 	}
 	if (limitX==0 || x<limitX-node_stride) {
-		toAdd.x = x+node_stride;
-		toAdd.y = y;
-		res.push_back(toAdd);
+		res[count].x = x+node_stride;
+		res[count].y = y;
+		count++;
 	}
 	if (limitY==0 || y<limitY-node_stride) {
-		toAdd.x = x;
-		toAdd.y = y+node_stride;
-		res.push_back(toAdd);
+		res[count].x = x;
+		res[count].y = y+node_stride;
+		count++;
 	}
 
-	return res;
+	return count;
 }
 
 
-float AStarNode::getActualCost() const {
+unsigned int AStarNode::getActualCost() const {
 	return g;
 }
 
-void AStarNode::setActualCost(const float G) {
+void AStarNode::setActualCost(const unsigned int G) {
 	g = G;
 }
 
-void AStarNode::setEstimatedCost(const float H) {
+void AStarNode::setEstimatedCost(const unsigned int H) {
 	h = H;
 }
 
-float AStarNode::getFinalCost() const {
-	return g+h*2.f;
+unsigned int AStarNode::getFinalCost() const {
+	return g+h*2;
 }
 
 bool AStarNode::operator<(const AStarNode& n) const {
@@ -27,11 +27,14 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #ifndef ASTARNODE_H
 #define ASTARNODE_H
 
-#include <list>
 #include "Utils.h"
 #include "pdcpp/graphics/Point.h"
 
 const int node_stride = 1; // minimal stride between nodes
+const int max_neighbours = 8; // a grid node has at most 8 neighbours
+
+// fixed-size span filled by AStarNode::getNeighbours, so no allocation happens per expanded node
+typedef pdcpp::Point<int> AStarNeighbours[max_neighbours];
 
 class AStarNode {
 protected:
@@ -40,9 +43,9 @@ protected:
 	int y;
 
 	// exact cost from first Node
-	float g;
+	unsigned int g;
 	// cost to last node
-	float h;
+	unsigned int h;
 	// Parent is where this Node come from.
     pdcpp::Point<int> parent;
 
@@ -52,20 +55,23 @@ public:
 
 	int getX() const;
 	int getY() const;
-	float getH() const;
+	unsigned int getH() const;
 
     pdcpp::Point<int> getParent() const;
 	void setParent(const pdcpp::Point<int>& p);
 
-	// return a list of coordinates of all neighbours
-	std::list<pdcpp::Point<int>> getNeighbours(int limitX=0, int limitY=0) const;
+	// reinitialise a pooled node for a new search
+	void reset(const pdcpp::Point<int>& p);
+
+	// fill res with the coordinates of all neighbours, returns how many were written
+	int getNeighbours(AStarNeighbours& res, int limitX=0, int limitY=0) const;
 
-	float getActualCost() const;
-	void setActualCost(const float G);
+	unsigned int getActualCost() const;
+	void setActualCost(const unsigned int G);
 
-	void setEstimatedCost(const float H);
+	void setEstimatedCost(const unsigned int H);
 
-	float getFinalCost() const;
+	unsigned int getFinalCost() const;
 
 	bool operator<(const AStarNode& n) const;
 	bool operator==(const AStarNode& n) const;
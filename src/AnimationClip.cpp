@@ -36,6 +36,34 @@ void AnimationClip::LoadImages()
     loaded = true;
 }
 
+bool AnimationClip::UseAtlas(const SpriteAtlas* _atlas, const std::string& clip)
+{
+    if (_atlas == nullptr) return false;
+    const SpriteAtlas::Clip frames = _atlas->FindClip(clip);
+    if (!frames.IsValid())
+    {
+        Log::Error("Atlas has no clip %s", clip.c_str());
+        return false;
+    }
+
+    atlas = _atlas;
+    firstFrame = frames.first;
+    frameCount = frames.count;
+    paths.clear();
+    loaded = true;
+    return true;
+}
+
+int AnimationClip::GetMemoryBytes() const
+{
+    int bytes = 0;
+    for (const auto& image : images)
+    {
+        bytes += SpriteAtlas::GetBitmapBytes(*image);
+    }
+    return bytes;
+}
+
 void AnimationClip::Draw(pdcpp::Point<int> location)
 {
     Draw(location.x, location.y);
@@ -43,7 +71,7 @@ void AnimationClip::Draw(pdcpp::Point<int> location)
 
 void AnimationClip::Draw(int x, int y)
 {
-    if (!loaded || images.empty())
+    if (!loaded || frameCount == 0)
     {
         Log::Error("Attempting to draw an unloaded or empty animation");
         return;
@@ -63,7 +91,12 @@ void AnimationClip::Draw(int x, int y)
         frameDelayCounter++;
     }
 
-    pdcpp::Point<int> position(x, y);
     LCDBitmapFlip flipMode = flip ? kBitmapFlippedX : kBitmapUnflipped;
+    if (atlas)
+    {
+        atlas->DrawFrame(firstFrame + currentframe, x, y, flipMode);
+        return;
+    }
+    pdcpp::Point<int> position(x, y);
     images[currentframe]->draw(position, flipMode);
 }
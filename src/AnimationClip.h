@@ -7,6 +7,7 @@
 #include "pdcpp/core/GlobalPlaydateAPI.h"
 #include "pdcpp/graphics/Image.h"
 #include "pdcpp/graphics/Point.h"
+#include "SpriteAtlas.h"
 
 #ifndef CARDOBLAST_ANIMATIONCLIP_H
 #define CARDOBLAST_ANIMATIONCLIP_H
@@ -19,10 +20,15 @@ public:
 
     void AddImagePath(const std::string& path);
     void LoadImages();
+    // Draw the frames of `clip` from a shared atlas instead of loose images. False if the atlas doesn't have it.
+    bool UseAtlas(const SpriteAtlas* atlas, const std::string& clip);
     void Draw(pdcpp::Point<int> location);
     void Draw(int x, int y);
     void SetDelay(int value){frameDelay = value; }
     void SetFlip(bool value){flip = value; }
+    [[nodiscard]] int GetFrameCount() const { return frameCount; }
+    // Bytes of the loose images, 0 when the frames live in an atlas
+    [[nodiscard]] int GetMemoryBytes() const;
 
 private:
     bool flip{false};
@@ -31,6 +37,8 @@ private:
     int frameCount{0};
     int frameDelay{0};
     int frameDelayCounter{0};
+    const SpriteAtlas* atlas{nullptr};
+    int firstFrame{0}; // index of the first frame in the atlas
 
     std::vector<std::unique_ptr<pdcpp::Image>> images;
     std::vector<std::string> paths;
@@ -1,6 +1,7 @@
 #include <utility>
 #include "Area.h"
 #include "Door.h"
+#include "DrawList.h"
 #include "Entity.h"
 #include "Dialogue.h"
 #include "Log.h"
@@ -13,8 +14,8 @@
 #include "pdcpp/graphics/Colors.h"
 #include "EntityManager.h"
 #include "Monster.h"
+#include "MonsterPrototypes.h"
 #include "Player.h"
-#include "EnemyProjectile.h"
 #include "pdcpp/core/Random.h"
 #include <algorithm>
 #include <memory>
@@ -29,7 +30,7 @@ Area::Area()
     lastActivityCheckTime = pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds();
 }
 
-Area::~Area() = default; // Destructor defined here so unique_ptr can see full EnemyProjectile definition
+Area::~Area() = default; // Destructor defined here so unique_ptr can see full type definitions
 
 Area::Area(unsigned int _id, const char* _name, std::shared_ptr<Dialogue> _dialogue, const std::vector<std::shared_ptr<Monster>>& _monsters)
     : Entity(_id), dialogue(std::move(_dialogue))
@@ -96,13 +97,13 @@ std::shared_ptr<void> Area::DecodeJson(char *buffer, jsmntok_t *tokens, const in
                 {
                     std::string door = Utils::Subchar(buffer, tokens[i+j].start, tokens[i+j].end);
                     int decodedDoor = std::stoi(door);
-                    auto originalInstance = entityManager->GetEntity(decodedDoor);
+                    auto originalInstance = entityManager->Get<Door>(decodedDoor);
                     if (originalInstance == nullptr)
                     {
                         Log::Error("Door with ID %d not found", decodedDoor);
                         continue;
                     }
-                    decodedDoors.push_back(std::static_pointer_cast<Door>(originalInstance));
+                    decodedDoors.push_back(originalInstance);
                 }
                 i=i+numOfDoors;
             }
@@ -114,13 +115,13 @@ std::shared_ptr<void> Area::DecodeJson(char *buffer, jsmntok_t *tokens, const in
                 for (int j = 0; j < numOfCreatures; j++)
                 {
                     int creatureId = std::stoi(Utils::Subchar(buffer, tokens[i+j].start, tokens[i+j].end));
-                    auto originalInstance = entityManager->GetEntity(creatureId);
+                    auto originalInstance = entityManager->Get<Monster>(creatureId);
                     if (originalInstance == nullptr)
                     {
                         Log::Error("Creature with ID %d not found", creatureId);
                         continue;
                     }
-                    decodedCreatures.push_back(std::static_pointer_cast<Monster>(originalInstance));
+                    decodedCreatures.push_back(originalInstance);
                 }
                 i=i+numOfCreatures;
             }
@@ -205,46 +206,99 @@ void Area::GenerateProceduralMap(int width, int height, UI* ui)
     
     Log::Info("Procedural map generated: %dx%d", width, height);
 }
-void Area::DrawTileFromLayer(int layer, int x, int y)
+int Area::DrawTileFromLayer(int layer, int x, int y)
 {
     int drawX = x * tileWidth;
     int drawY = y * tileHeight;
     pdcpp::Rectangle<int> tileRect(drawX, drawY, tileWidth, tileHeight);
+    return MapRenderer::DrawTile(mapData[layer].tiles[(y * width) + x], tileRect);
+}
+void Area::ResetMapRenderer()
+{
+    if (!Globals::PRERENDER_MAP || mapData.empty()) return;
+    mapRenderer.Reset(width, height, tileWidth, tileHeight);
+}
+pdcpp::Rectangle<int> Area::GetVisibleTiles(int x, int y, int fovX, int fovY) const
+{
+    if (tileWidth <= 0 || tileHeight <= 0) return {};
+
+    // A tile is visible when its corner is less than the FOV away: x - fov < i * tileWidth < x + fov
+    const auto floorDiv = [](const int value, const int divisor) { return value >= 0 ? value / divisor : -((divisor - 1 - value) / divisor); };
+    const int firstX = std::max(0, floorDiv(x - fovX, tileWidth) + 1);
+    const int firstY = std::max(0, floorDiv(y - fovY, tileHeight) + 1);
+    const int lastX = std::min(width - 1, floorDiv(x + fovX - 1, tileWidth));
+    const int lastY = std::min(height - 1, floorDiv(y + fovY - 1, tileHeight));
+    if (lastX < firstX || lastY < firstY) return {};
+    return {firstX, firstY, lastX - firstX + 1, lastY - firstY + 1};
+}
+void Area::SubmitDraw(DrawList& drawList)
+{
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float startTime = system->getElapsedTime();
+    renderStats = RenderStats();
 
-    if (mapData[layer].tiles[(y * width) + x].collision) {
-        // Obstacle tiles - draw dark rectangles with white border
-        pdcpp::Graphics::fillRectangle(tileRect, pdcpp::Colors::black);
-        // Draw border for obstacles to make them stand out
-        pdcpp::Graphics::drawRectangle(tileRect, pdcpp::Colors::white);
-    } else {
-        // Walkable tiles - draw light gray ground
-        pdcpp::Graphics::fillRectangle(tileRect, pdcpp::Colors::solid50GrayA);
+    // Culling only reads the packed position array, monster objects are touched when they're visible
+    const std::vector<pdcpp::Point<int>>& monsterPositions = livingMonsters.GetPositions();
+    for (int slot = 0; slot < livingMonsters.Size(); ++slot)
+    {
+        if (!drawList.IsVisible(monsterPositions[slot])) continue;
+        livingMonsters.GetMonster(slot)->SubmitDraw(drawList);
+        renderStats.monstersDrawn++;
+    }
+    for (int index = 0; index < enemyProjectiles.Size(); ++index)
+    {
+        const pdcpp::Point<int> position = enemyProjectiles.GetPosition(index);
+        if (!drawList.IsVisible(position)) continue;
+        drawList.SubmitEnemyProjectile(enemyProjectiles, index, position.y);
     }
+
+    renderStats.timeUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
 }
-void Area::Render(int x, int y, int fovX, int fovY)
+void Area::RenderMap(int x, int y, int fovX, int fovY)
 {
-    for (int i = 0; i < width; i++)
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float startTime = system->getElapsedTime();
+
+    // Only the tiles in the field of view are visited, never the whole map
+    if (!mapData.empty())
     {
-        for (int j = 0; j < height; j++)
+        const pdcpp::Rectangle<int> visibleTiles = GetVisibleTiles(x, y, fovX, fovY);
+        renderStats.tilesVisited = visibleTiles.width * visibleTiles.height;
+        if (mapRenderer.IsReady())
         {
-            bool visibleX = abs(x-(i*tileWidth)) < fovX;
-            bool visibleY = abs(y-(j*tileHeight)) < fovY;
-            if (visibleX && visibleY)
-            {
-                DrawTileFromLayer(0, i, j); // The first layer is the only one to draw
-            }
+            mapRenderer.Draw(mapData[0], visibleTiles, renderStats); // The first layer is the only one to draw
+        }
+        else
+        {
+            renderStats.mapDrawCalls = MapRenderer::DrawTiles(mapData[0], width, visibleTiles, tileWidth, tileHeight);
         }
     }
-    for (const auto& monster : livingMonsters)
+    mapChanged = false;
+
+    renderStats.timeUs += static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+    if (Globals::RENDER_STATS_LOG_INTERVAL > 0 && ++renderedFrames % Globals::RENDER_STATS_LOG_INTERVAL == 0)
+    {
+        Log::Info("Area render: %d map draw calls, %d tiles visited, %d chunks rasterised, %d monsters, %d us",
+                  renderStats.mapDrawCalls, renderStats.tilesVisited, renderStats.chunksRasterised, renderStats.monstersDrawn, renderStats.timeUs);
+    }
+}
+void Area::SetTile(int x, int y, const Tile& tile)
+{
+    if (mapData.empty() || x < 0 || y < 0 || x >= width || y >= height) return;
+
+    Tile& current = mapData[0].tiles[(y * width) + x];
+    const bool collisionChanged = current.collision != tile.collision;
+    current = tile;
+    mapRenderer.MarkTileDirty(x, y);
+    mapChanged = true;
+
+    if (collisionChanged && collider)
     {
-        auto monsterPos = monster->GetPosition();
-        bool visibleX = abs(x - monsterPos.x) < fovX;
-        bool visibleY = abs(y - monsterPos.y) < fovY;
-        if (!visibleX || !visibleY) continue;
-        monster->Draw();
+        collider->SetMap(ToMapLayer(), width, height);
+        RebuildMonsterTracking();
+        playerFlowField.Invalidate();
+        pathHierarchy.Invalidate();
     }
-    // Draw enemy projectiles after monsters
-    DrawEnemyProjectiles();
 }
 bool Area::CheckCollision(int x, int y) const
 {
@@ -586,8 +640,10 @@ bool Area::ContinueMapGeneration()
             // Set up collision and spawn points
             collider = std::make_shared<MapCollision>();
             collider->SetMap(ToMapLayer(), width, height);
+            RebuildMonsterTracking();
             LoadSpawnablePositions();
             SetupMonstersToSpawn();
+            ResetMapRenderer();
 
             Log::Info("Procedural map generated incrementally: %dx%d", width, height);
             return true; // Complete!
@@ -603,25 +659,31 @@ void Area::LoadFromSavedData()
     // We just need to set up collision and spawn points
     collider = std::make_shared<MapCollision>();
     collider->SetMap(ToMapLayer(), width, height);
+    RebuildMonsterTracking(); // monsters restored from the save were added before the collider existed
     LoadSpawnablePositions();
     SetupMonstersToSpawn();
+    ResetMapRenderer();
 }
 void Area::Unload()
 {
     mapData.clear();
     imageTable = nullptr;
+    mapRenderer.Invalidate();
 
-    // Clean up all monster vectors
-    livingMonsters.clear();
+    // Clean up all monster vectors. The pool keeps its instances for the next map.
+    livingMonsters.Clear();
+    monsterPool.ReleaseAll();
     toSpawnMonsters.clear();
 
     // Clean up enemy projectiles
-    enemyProjectiles.clear();
+    enemyProjectiles.Clear();
 
     // Clean up other resources
     spawnablePositions.clear();
-    pathfindingContainer.reset();
     collider.reset();
+    playerFlowField.Invalidate();
+    pathScheduler.Clear();
+    pathHierarchy.Invalidate();
     
     // Reset generation state
     currentGenerationStep = GenerationStep::None;
@@ -635,15 +697,17 @@ void Area::SetupMonstersToSpawn()
     int monstersToSetup = Globals::MONSTER_TOTAL_TO_SPAWN - monstersSpawnedCount;
 
     // Ensure we don't spawn negative monsters
-    if (monstersToSetup <= 0) {
+    if (monstersToSetup <= 0 || bankOfMonsters.empty()) {
         return;
     }
 
+    // Only the prototypes are picked here, the monsters are copied into pooled instances when they spawn
+    monsterPool.Reserve(Globals::MONSTER_MAX_LIVING_COUNT);
+    toSpawnMonsters.reserve(monstersToSetup);
     for (int i=0; i< monstersToSetup; i++)
     {
         unsigned int randomIndex = random.next() % static_cast<unsigned int>(bankOfMonsters.size());
-        auto monster = std::make_shared<Monster>(*bankOfMonsters[randomIndex]);
-        toSpawnMonsters.push_back(monster);
+        toSpawnMonsters.push_back(MonsterPrototypes::IndexOf(*bankOfMonsters[randomIndex]));
     }
 }
 void Area::SpawnCreature()
@@ -655,7 +719,7 @@ void Area::SpawnCreature()
     }
     int monstersToSpawn = Globals::MONSTER_TOTAL_TO_SPAWN - monstersSpawnedCount;
     if (monstersToSpawn <= 0 || toSpawnMonsters.empty()) return; // don't spawn more monsters if the max count is reached
-    if (livingMonsters.size() >= Globals::MONSTER_MAX_LIVING_COUNT) return; // don't spawn more monsters if the max count is reached
+    if (livingMonsters.Size() >= Globals::MONSTER_MAX_LIVING_COUNT) return; // don't spawn more monsters if the max count is reached
 
     auto spawnPos = FindSpawnablePosition(0);
     if (spawnPos.x == 0 && spawnPos.y == 0)
@@ -663,14 +727,73 @@ void Area::SpawnCreature()
         return; // no spawnable position found
     }
 
-    std::shared_ptr<Monster> monster = toSpawnMonsters[0];
-    livingMonsters.push_back(monster);
-    livingMonsters.back()->LoadBitmap();
-    livingMonsters.back()->SetTiledPosition(spawnPos); // set a default position for the monster
-    toSpawnMonsters.erase(toSpawnMonsters.begin());
+    // The template already holds the bitmap, so this only copies plain fields
+    std::shared_ptr<Monster> monster = monsterPool.Acquire(MonsterPrototypes::GetInstanceTemplate(toSpawnMonsters.back()));
+    if (!monster) return; // every instance is alive, the living count keeps this from happening
+    monster->SetTiledPosition(spawnPos); // set a default position for the monster
+    OccupyTile(livingMonsters.Add(monster));
+    toSpawnMonsters.pop_back();
     ticksSinceLastSpawn = 0; // reset the spawn timer
     monstersSpawnedCount++; // track total spawned monsters
 }
+void Area::AddLivingMonster(const std::shared_ptr<Monster>& monster)
+{
+    OccupyTile(livingMonsters.Add(monster));
+}
+std::shared_ptr<Monster> Area::CreateMonster(const Monster& bankMonster)
+{
+    const Monster& instanceTemplate = MonsterPrototypes::GetInstanceTemplate(MonsterPrototypes::IndexOf(bankMonster));
+    monsterPool.Reserve(Globals::MONSTER_MAX_LIVING_COUNT);
+    if (auto monster = monsterPool.Acquire(instanceTemplate)) return monster;
+    return std::make_shared<Monster>(instanceTemplate);
+}
+void Area::ClearLivingMonsters()
+{
+    for (int slot = 0; slot < livingMonsters.Size(); ++slot)
+    {
+        ReleaseTile(slot);
+        monsterPool.Release(*livingMonsters.GetMonster(slot));
+    }
+    livingMonsters.Clear(); // invalidates every handle, before any instance is acquired again
+}
+void Area::DespawnMonster(const int slot)
+{
+    ReleaseTile(slot);
+    monsterPool.Release(*livingMonsters.GetMonster(slot));
+    livingMonsters.Remove(slot); // bumps the handle's generation, so targets and path requests drop it
+}
+/// Count the monster on the tile it stands on. Does nothing if it's already counted there.
+void Area::OccupyTile(const int slot)
+{
+    if (!collider) return;
+    const pdcpp::Point<int> tile = livingMonsters.GetTiledPosition(slot);
+    if (livingMonsters.IsOccupyingTile(slot))
+    {
+        if (livingMonsters.GetOccupiedTile(slot) == tile) return;
+        ReleaseTile(slot);
+    }
+    collider->block(static_cast<float>(tile.x), static_cast<float>(tile.y), true);
+    livingMonsters.SetOccupiedTile(slot, tile);
+}
+void Area::ReleaseTile(const int slot)
+{
+    if (!livingMonsters.IsOccupyingTile(slot)) return;
+    if (collider)
+    {
+        const pdcpp::Point<int> tile = livingMonsters.GetOccupiedTile(slot);
+        collider->unblock(static_cast<float>(tile.x), static_cast<float>(tile.y), true);
+    }
+    livingMonsters.ClearOccupiedTile(slot);
+}
+/// A new map starts with an empty occupancy layer and monster grid, so every living monster is added again.
+void Area::RebuildMonsterTracking()
+{
+    livingMonsters.Reset(width * Globals::MAP_TILE_SIZE, height * Globals::MAP_TILE_SIZE);
+    for (int slot = 0; slot < livingMonsters.Size(); ++slot)
+    {
+        OccupyTile(slot);
+    }
+}
 /// Find a spawnable position in the area, out of the sight of the player and not colliding with any tile.
 pdcpp::Point<int> Area::FindSpawnablePosition(int attemptCount)
 {
@@ -922,69 +1045,55 @@ void Area::Tick(Player* player)
 
     SpawnCreature(); // we'll be spawning creatures as long as there's space for them and haven't reached the max count
 
-    // Then, we will mark the positions of the monsters as blocked in the collider
-    std::vector<pdcpp::Point<int>> blockPositions = std::vector<pdcpp::Point<int>>();
-    for (size_t i = 0; i < livingMonsters.size(); ++i)
+    // Build the pathfinding cluster graph a few clusters at a time, so big maps don't stall a frame
+    if (!pathHierarchy.IsReady(collider.get()))
     {
-        auto& monster = livingMonsters[i];
-        auto monsterPos = monster->GetTiledPosition();
-        blockPositions.emplace_back(monsterPos);
-        collider->block(
-            static_cast<float>(monsterPos.x),
-            static_cast<float>(monsterPos.y),
-            true);
-        monster->SetCanComputePath((i%staggerAmount) == pathfindingTickCounter); // stagger the pathfinding updates
+        pathHierarchy.ContinueBuild(collider.get(), Globals::HPA_CLUSTERS_PER_TICK);
     }
-    pathfindingTickCounter = (pathfindingTickCounter + 1) % staggerAmount;
 
-    // Then, we will tick the monsters. So they can calculate paths and move
-    for (const auto& monster : livingMonsters)
-    {
-        // We avoid the monsters from blocking itself by unblocking its position before ticking it.
-        auto monsterPos = monster->GetTiledPosition();
-        collider->unblock(
-            static_cast<float>(monsterPos.x),
-            static_cast<float>(monsterPos.y));
+    // Refresh the shared flow field. It is only rebuilt when the player moves to another tile or the map changes
+    playerFlowField.Update(collider.get(), player->GetTiledPosition());
 
-        // remove the monster position from the block positions because its position will change
-        auto it = std::ranges::find(blockPositions, monsterPos);
-        if (it != blockPositions.end())
+    // Run the path requests made by the monsters, most urgent first, until the frame budget is spent
+    for (int slot = 0; slot < livingMonsters.Size(); ++slot)
+    {
+        if (livingMonsters.GetMonster(slot)->HasPathRequest())
         {
-            blockPositions.erase(it);
+            pathScheduler.Request(livingMonsters.GetHandle(slot), livingMonsters.GetPosition(slot), player->GetPosition());
         }
-
-
-        monster->Tick(player, this);
-        monsterPos = monster->GetTiledPosition();
-        blockPositions.emplace_back(monsterPos);
-        collider->block(
-            static_cast<float>(monsterPos.x),
-            static_cast<float>(monsterPos.y),
-            true);
     }
+    pathScheduler.Run(this);
 
-    // Finally, we will unblock the positions of the monsters
-    for (auto blockedPosition : blockPositions)
+    // Then, we will tick the monsters. So they can calculate paths and move.
+    // Their tiles stay blocked in the collider, only the ones that stepped on another tile are updated.
+    for (int slot = 0; slot < livingMonsters.Size(); ++slot)
     {
-        collider->unblock(
-            static_cast<float>(blockedPosition.x),
-            static_cast<float>(blockedPosition.y));
+        livingMonsters.GetMonster(slot)->Tick(player, this, slot);
+        livingMonsters.Sync(slot);
+        OccupyTile(slot);
     }
 
+    // Move the enemy projectiles, including the ones fired this tick. The ones hitting a wall are removed.
+    // Read the time again, projectiles fired during the monster ticks are stamped after currentTime.
+    enemyProjectiles.Update(collider.get(), pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds());
+
+    // Resolve every projectile hit of the tick in one pass, so dead monsters are counted below
+    collisionPhase.Run(livingMonsters, player->GetLaunchedMagic(), enemyProjectiles, player);
+
     // Count dead monsters and accumulate XP before removing them
     size_t deadMonsters = 0;
     unsigned int xpGained = 0;
-    for (const auto& monster : livingMonsters)
+    // Removing moves the last monster into the freed slot, so walk backwards
+    for (int slot = livingMonsters.Size() - 1; slot >= 0; --slot)
     {
-        if (!monster->IsAlive())
+        const Monster& monster = *livingMonsters.GetMonster(slot);
+        if (!monster.IsAlive())
         {
             deadMonsters++;
-            xpGained += monster->GetXP();
+            xpGained += monster.GetXP();
+            DespawnMonster(slot);
         }
     }
-    std::erase_if(livingMonsters,
-                  [](const std::shared_ptr<Monster>& monster)
-                  { return !monster->IsAlive(); });
 
     // Increment player's kill count and award XP for each dead monster
     for (size_t i = 0; i < deadMonsters; ++i)
@@ -995,101 +1104,21 @@ void Area::Tick(Player* player)
     {
         player->AddXP(xpGained);
     }
-    
-    // Update enemy projectiles
-    UpdateEnemyProjectiles(player);
 }
 Map_Layer Area::ToMapLayer() const
 {
-    Map_Layer layer(width, std::vector<unsigned short>(height, 0));
-    for (int x = 0; x < width; ++x)
+    // Both are row-major, so this is a straight copy
+    const std::vector<Tile>& tiles = mapData[0].tiles;
+    Map_Layer layer(tiles.size(), MapCollision::BLOCKS_NONE);
+    for (size_t i = 0; i < tiles.size(); ++i)
     {
-        for (int y = 0; y < height; ++y)
-        {
-            const Tile& tile = mapData[0].tiles[y * width + x];
-            layer[x][y] = tile.collision ? MapCollision::BLOCKS_ALL : MapCollision::BLOCKS_NONE;
-        }
+        layer[i] = tiles[i].collision ? MapCollision::BLOCKS_ALL : MapCollision::BLOCKS_NONE;
     }
     return layer;
 }
-void Area::SetUpPathfindingContainer()
-{
-    pathfindingContainer = std::make_shared<AStarContainer>(width, height, width*height);
-    for (int i = 0; i < width; i++)
-    {
-        for (int j = 0; j < height; j++)
-        {
-            if (CheckCollision(i * tileWidth, j * tileHeight)) continue;
-            auto* node = new AStarNode(pdcpp::Point<int>(i, j));
-            pathfindingContainer->Add(node);
-        }
-    }
-}
 
 void Area::CreateEnemyProjectile(pdcpp::Point<int> position, float angle, float speed, unsigned int size, float damage)
 {
-    if (!entityManager)
-    {
-        return;
-    }
-    
-    auto playerPtr = entityManager->GetPlayer();
-    if (!playerPtr)
-    {
-        return;
-    }
-    
-    auto projectile = std::make_unique<EnemyProjectile>(
-        position,
-        std::weak_ptr<Player>(playerPtr),
-        angle,
-        speed,
-        size,
-        damage
-    );
-    enemyProjectiles.push_back(std::move(projectile));
+    const unsigned int currentTime = pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds();
+    enemyProjectiles.Fire(position, angle, speed, size, damage, currentTime);
 }
-
-void Area::AddEnemyProjectile(std::unique_ptr<EnemyProjectile> projectile)
-{
-    enemyProjectiles.push_back(std::move(projectile));
-}
-
-void Area::UpdateEnemyProjectiles(Player* player)
-{
-    if (!player)
-    {
-        return;
-    }
-    
-    // Create a shared_ptr to this Area for the Update call
-    // We use a custom deleter that does nothing since Area is managed elsewhere
-    std::shared_ptr<Area> areaShared(this, [](Area*) {});
-    
-    // Update all projectiles
-    for (auto& projectile : enemyProjectiles)
-    {
-        if (projectile && projectile->IsAlive())
-        {
-            projectile->Update(areaShared);
-        }
-    }
-    
-    // Remove dead projectiles
-    enemyProjectiles.erase(
-        std::remove_if(enemyProjectiles.begin(), enemyProjectiles.end(),
-            [](const std::unique_ptr<EnemyProjectile>& p) { return !p || !p->IsAlive(); }),
-        enemyProjectiles.end()
-    );
-}
-
-void Area::DrawEnemyProjectiles() const
-{
-    for (const auto& projectile : enemyProjectiles)
-    {
-        if (projectile && projectile->IsAlive())
-        {
-            projectile->Draw();
-        }
-    }
-}
\ No newline at end of file
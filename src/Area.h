@@ -2,40 +2,46 @@
 #define AREA_H
 
 #include "Inventory.h"
+#include "CollisionPhase.h"
 #include "Dialogue.h"
-#include "AStarContainer.h"
+#include "EnemyProjectileSystem.h"
+#include "FlowField.h"
 #include "Globals.h"
+#include "HierarchicalPathfinder.h"
 #include "MapCollision.h"
 #include "MapGenerationTypes.h"
+#include "MapRenderer.h"
+#include "MonsterPool.h"
+#include "MonsterStore.h"
+#include "PathScheduler.h"
 #include "pdcpp/core/Random.h"
 #include "pdcpp/graphics/ImageTable.h"
 #include <memory>
 #include <vector>
 
+class DrawList;
 class EntityManager;
 class Door;
 class Monster;
 class Player;
-class EnemyProjectile;
 class UI;
 class ProceduralMapGenerator;
 
-struct Tile {
-    int id;
-    bool collision;
-};
-
-struct Layer {
-    std::vector<Tile> tiles;
-};
-
 class Area final : public Entity
 {
 private:
     EntityManager* entityManager = nullptr;
     std::vector<Layer> mapData;
     std::shared_ptr<MapCollision> collider;
+    FlowField playerFlowField; // shared distance field towards the player, used by AStar monsters
+    HierarchicalPathfinder pathHierarchy; // cluster graph for long queries, built over the first ticks of a map
+    PathScheduler pathScheduler; // runs monster path requests within a per frame time budget
+    CollisionPhase collisionPhase; // resolves the projectile hits of a tick in one pass
     std::unique_ptr<pdcpp::ImageTable> imageTable;
+    MapRenderer mapRenderer; // the tiles, cached in chunk bitmaps as they become visible
+    RenderStats renderStats;
+    int renderedFrames = 0;
+    bool mapChanged = false; // SetTile was called since the map was last drawn
     int width{};
     int height{};
     int tileWidth{};
@@ -45,16 +51,23 @@ private:
     std::shared_ptr<Dialogue> dialogue;
     std::vector<std::shared_ptr<Door>> doors;
     std::vector<std::shared_ptr<Monster>> bankOfMonsters; // the type of monsters to spawn in the area
-    std::vector<std::shared_ptr<Monster>> livingMonsters; // the monsters that are currently alive in the area
-    std::vector<std::shared_ptr<Monster>> toSpawnMonsters; // the monsters that haven't been spawned yet
-    std::shared_ptr<AStarContainer> pathfindingContainer;
-    std::vector<std::unique_ptr<EnemyProjectile>> enemyProjectiles; // enemy projectiles in the area
+    MonsterStore livingMonsters; // the monsters that are currently alive in the area, with their hot fields packed
+    MonsterPool monsterPool; // recycled instances the living monsters are spawned into
+    std::vector<int> toSpawnMonsters; // MonsterPrototypes indices of the monsters that haven't been spawned yet, spawned from the back
+    EnemyProjectileSystem enemyProjectiles; // enemy projectiles in the area
     void SpawnCreature();
+    // Living monsters stay counted in the collider's occupancy layer, only tile changes touch it
+    void OccupyTile(int slot);
+    void ReleaseTile(int slot);
+    // Remove a living monster and give its instance back to the pool. Handles to it stop resolving.
+    void DespawnMonster(int slot);
+    void RebuildMonsterTracking();
+    void ResetMapRenderer();
+    // Tiles inside the field of view around a pixel position, clamped to the map
+    [[nodiscard]] pdcpp::Rectangle<int> GetVisibleTiles(int x, int y, int fovX, int fovY) const;
     [[nodiscard]] Map_Layer ToMapLayer() const;
     pdcpp::Random random = {};
     std::vector<pdcpp::Point<int>> spawnablePositions; // positions where monsters can spawn
-    int pathfindingTickCounter = 0; // Counter to stagger pathfinding updates
-    const int staggerAmount = Globals::MONSTER_MAX_LIVING_COUNT; // Number of groups to stagger
     bool isProcedural = false; // Flag to indicate if map is procedurally generated
 
     // Incremental map generation state
@@ -107,11 +120,17 @@ public:
     Area(Area&& other) noexcept;
     Area(unsigned int _id, const char* _name, std::shared_ptr<Dialogue> _dialogue, const std::vector<std::shared_ptr<Monster>>& _monsters);
 
-    [[nodiscard]] std::vector<std::shared_ptr<Monster>> GetCreatures() const {return livingMonsters;}
+    [[nodiscard]] const std::vector<std::shared_ptr<Monster>>& GetCreatures() const {return livingMonsters.GetMonsters();}
+    [[nodiscard]] MonsterStore& GetMonsterStore() {return livingMonsters;}
+    [[nodiscard]] const MonsterPool& GetMonsterPool() const {return monsterPool;}
+    [[nodiscard]] const CollisionStats& GetCollisionStats() const {return collisionPhase.GetStats();}
+    [[nodiscard]] const RenderStats& GetRenderStats() const {return renderStats;}
     [[nodiscard]] std::vector<std::shared_ptr<Monster>> GetMonsterBank() const {return bankOfMonsters;}
     [[nodiscard]] int GetMonstersSpawnedCount() const {return monstersSpawnedCount;}
-    void AddLivingMonster(const std::shared_ptr<Monster>& monster) {livingMonsters.push_back(monster);}
-    void ClearLivingMonsters() {livingMonsters.clear();}
+    void AddLivingMonster(const std::shared_ptr<Monster>& monster);
+    // Pooled instance of the prototype of `bankMonster`, falls back to a new instance when the pool is exhausted
+    [[nodiscard]] std::shared_ptr<Monster> CreateMonster(const Monster& bankMonster);
+    void ClearLivingMonsters();
     void ClearToSpawnMonsters() {toSpawnMonsters.clear();}
     void SetMonstersSpawnedCount(int count) {monstersSpawnedCount = count;}
 
@@ -120,11 +139,21 @@ public:
     void LoadLayers(std::string fileName, int limitOfTokens);
     void LoadImageTable(std::string fileName);
     void GenerateProceduralMap(int width = 40, int height = 40, UI* ui = nullptr);
-    void DrawTileFromLayer(int layer, int x, int y);
-    void Render(int x, int y, int fovX, int fovY);
+    int DrawTileFromLayer(int layer, int x, int y); // Returns the graphics calls spent
+    // Submits the visible monsters and enemy projectiles to `drawList`, call it before RenderMap
+    void SubmitDraw(DrawList& drawList);
+    // Draws the tiles in the field of view
+    void RenderMap(int x, int y, int fovX, int fovY);
+    // A tile changed since the map was last drawn, see SetTile
+    [[nodiscard]] bool HasMapChanged() const {return mapChanged;}
     bool CheckCollision(int x, int y) const;
+    /**
+     * @brief Change a tile of the drawn layer at runtime. Only its render chunk is rasterised again.
+     *
+     * If the collision flag changes, the collider and the pathfinding caches built from it are rebuilt too, which is costly.
+     */
+    void SetTile(int x, int y, const Tile& tile);
     void Tick(Player* player);
-    void SetUpPathfindingContainer();
     void Unload();
     void SetupMonstersToSpawn();
     void LoadWithUI(UI* ui); // Load with UI for progress reporting - starts incremental generation
@@ -141,7 +170,6 @@ public:
     [[nodiscard]] float GetPlayerIdleTime() const { return playerIdleTime; }
     [[nodiscard]] bool IsSlowdownActive() const { return slowdownActive; }
 
-    [[nodiscard]] std::shared_ptr<AStarContainer> GetPathfindingContainer() const {return pathfindingContainer;}
     [[nodiscard]] std::vector<std::shared_ptr<Door>> GetDoors() const {return doors;}
 
     [[nodiscard]] int GetWidth() const {return width;};
@@ -149,14 +177,15 @@ public:
     [[nodiscard]] int GetTileWidth() const {return tileWidth;};
     [[nodiscard]] int GetTileHeight() const {return tileHeight;};
     [[nodiscard]] MapCollision* GetCollider() const {return collider.get();}
+    [[nodiscard]] const FlowField& GetPlayerFlowField() const {return playerFlowField;}
+    [[nodiscard]] HierarchicalPathfinder* GetPathHierarchy() {return &pathHierarchy;}
+    [[nodiscard]] const PathScheduler& GetPathScheduler() const {return pathScheduler;}
 
     void SetEntityManager(EntityManager* manager) { entityManager = manager; }
     
     // Enemy projectile management
     void CreateEnemyProjectile(pdcpp::Point<int> position, float angle, float speed, unsigned int size, float damage);
-    void AddEnemyProjectile(std::unique_ptr<EnemyProjectile> projectile);
-    void UpdateEnemyProjectiles(Player* player);
-    void DrawEnemyProjectiles() const;
+    [[nodiscard]] const EnemyProjectileSystem& GetEnemyProjectiles() const {return enemyProjectiles;}
 };
 
 #endif
\ No newline at end of file
@@ -6,10 +6,11 @@
 #include "pdcpp/core/GlobalPlaydateAPI.h"
 #include "Log.h"
 #include "Monster.h"
+#include "MonsterStore.h"
 #include <cmath>
 
-AutoProjectile::AutoProjectile(pdcpp::Point<int> Position, std::weak_ptr<Player> _player, std::weak_ptr<Monster> _target):
-Magic(Position, std::move(_player)), target(std::move(_target))
+AutoProjectile::AutoProjectile(pdcpp::Point<int> Position, Player* _player, const MonsterStore* _monsters, GenerationalHandle _target):
+Magic(Position, _player), monsters(_monsters), target(_target)
 {
     iLifetime = 3000; // 3 seconds max lifetime
     speed = 6.0f;
@@ -31,7 +32,7 @@ void AutoProjectile::Draw() const
 void AutoProjectile::HandleInput()
 {
     // Check if target is still alive
-    auto targetPtr = target.lock();
+    const Monster* targetPtr = monsters->Get(target);
     if (!targetPtr || !targetPtr->IsAlive())
     {
         Terminate();
@@ -61,22 +62,26 @@ void AutoProjectile::HandleInput()
     }
 }
 
-void AutoProjectile::Damage(const std::shared_ptr<Area>& area)
+HitShape AutoProjectile::GetHitShape() const
 {
-    auto targetPtr = target.lock();
+    const Monster* targetPtr = monsters->Get(target);
     if (!targetPtr || !targetPtr->IsAlive())
     {
-        return;
+        return {};
     }
+    return HitShape::Circle(GetCenteredPosition(), static_cast<float>(size));
+}
 
-    auto projectileCenteredPos = GetCenteredPosition();
-    float distance = projectileCenteredPos.distance(targetPtr->GetCenteredPosition());
-
-    if (distance < static_cast<float>(size))
+void AutoProjectile::OnHit(Monster& monster)
+{
+    // Only the locked target can be hit
+    if (monsters->Get(target) != &monster || !monster.IsAlive())
     {
-        targetPtr->Damage(0.3f); // Small damage for passive ability
-        Terminate();
+        return;
     }
+
+    monster.Damage(0.3f); // Small damage for passive ability
+    Terminate();
 }
 
 pdcpp::Point<int> AutoProjectile::GetCenteredPosition() const
@@ -6,23 +6,28 @@
 #define CARDOBLAST_AUTOPROJECTILE_H
 
 #include "pdcpp/graphics/Point.h"
+#include "GenerationalHandle.h"
 #include "Magic.h"
 
 class Monster;
+class MonsterStore;
 
-class AutoProjectile : public Magic{
+class AutoProjectile final : public Magic{
 public:
     AutoProjectile() = delete;
-    explicit AutoProjectile(pdcpp::Point<int> Position, std::weak_ptr<Player> player, std::weak_ptr<Monster> target);
+    explicit AutoProjectile(pdcpp::Point<int> Position, Player* player, const MonsterStore* monsters, GenerationalHandle target);
     bool operator==(const AutoProjectile& other) const {return this == &other;}
 
     void Draw() const override;
     void HandleInput() override;
-    void Damage(const std::shared_ptr<Area>& area) override;
+    [[nodiscard]] HitShape GetHitShape() const override;
+    void OnHit(Monster& monster) override;
     pdcpp::Point<int> GetCenteredPosition() const;
 
 private:
-    std::weak_ptr<Monster> target;
+    // Locked target, resolved through the store of the area every tick
+    const MonsterStore* monsters;
+    GenerationalHandle target;
     float speed;
     unsigned int size;
 };
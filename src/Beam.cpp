@@ -8,13 +8,13 @@
 #include "Log.h"
 #include "Monster.h"
 
-Beam::Beam(pdcpp::Point<int> Position, std::weak_ptr<Player> _player)
-    : Beam(Position, std::move(_player), 1, 150.0f, 300, 0.4f)
+Beam::Beam(pdcpp::Point<int> Position, Player* _player)
+    : Beam(Position, _player, 1, 150.0f, 300, 0.4f)
 {}
 
-Beam::Beam(pdcpp::Point<int> Position, std::weak_ptr<Player> _player,
+Beam::Beam(pdcpp::Point<int> Position, Player* _player,
            unsigned int _size, float _length, unsigned int _explosionThreshold, float _damage) :
-    Magic(Position, std::move(_player)), startPosition(position), endPosition(Position) {
+    Magic(Position, _player), startPosition(position), endPosition(Position) {
     iLifetime = 2000;
     size = _size;
     beamLength = _length;
@@ -34,9 +34,8 @@ void Beam::HandleInput()
     float angle = pdcpp::GlobalPlaydateAPI::get()->system->getCrankAngle()* kPI /180.f;
     float startDistance = 30.f;
     float length = beamLength;
-    std::shared_ptr<Player> p = player.lock();
-    if (!p) return; //Player has been destroyed
-    position = p->GetCenteredPosition();
+    if (!player) return;
+    position = player->GetCenteredPosition();
     startPosition.x = position.x + (int)(cos(angle) * startDistance);
     startPosition.y = position.y + (int)(sin(angle) * startDistance);
     endPosition.x = position.x + (int)(cos(angle) * length);
@@ -50,38 +49,16 @@ void Beam::HandleInput()
     exploding = iLifetime - elapsedTime < explosionThreshold;
 }
 
-void Beam::Damage(const std::shared_ptr<Area>& area)
+HitShape Beam::GetHitShape() const
 {
-    if (!exploding) return;
-    int xi = startPosition.x;
-    int xf = endPosition.x;
-    int yi = startPosition.y;
-    int yf = endPosition.y;
-
-    for (auto& entity : area->GetCreatures())
-    {
-        pdcpp::Point<int> creaturePos = entity->GetPosition();
-
-        // Calculate the projection of the creature position onto the beam line
-        const int dx = xf - xi;
-        const int dy = yf - yi;
-        const double lineLength = sqrt(pow(dx, 2) + pow(dy, 2));
-
-        // Calculate parametric t value (0 = start, 1 = end of beam)
-        const double t = ((creaturePos.x - xi) * dx + (creaturePos.y - yi) * dy) / (lineLength * lineLength);
+    if (!exploding) return {};
+    // Creatures projecting inside the beam segment (not beyond start or end) and closer to its line than the beam size
+    return HitShape::Segment(startPosition, endPosition, static_cast<float>(size));
+}
 
-        // Only check distance if creature is within the beam segment (not beyond start or end)
-        if (t >= 0.0 && t <= 1.0)
-        {
-            // Calculate the perpendicular distance from the line segment to the point
-            const int numerator = abs((yf - yi) * (xi - creaturePos.x) - (xf - xi) * (yi - creaturePos.y));
-            const double denominator = lineLength;
-            if ((numerator / denominator) < size)
-            {
-                entity->Damage(damagePerHit);
-            }
-        }
-    }
+void Beam::OnHit(Monster& monster)
+{
+    monster.Damage(damagePerHit);
 }
 
 
@@ -8,16 +8,17 @@
 #include "pdcpp/graphics/Point.h"
 #include "Magic.h"
 
-class Beam : public Magic{
+class Beam final : public Magic{
 public:
     Beam() = delete;
-    explicit Beam(pdcpp::Point<int> Position, std::weak_ptr<Player> player);
-    Beam(pdcpp::Point<int> Position, std::weak_ptr<Player> player, unsigned int size, float length, unsigned int explosionThreshold, float damage);
+    explicit Beam(pdcpp::Point<int> Position, Player* player);
+    Beam(pdcpp::Point<int> Position, Player* player, unsigned int size, float length, unsigned int explosionThreshold, float damage);
     bool operator==(const Beam& other) const {return this == &other;}
 
     void Draw() const override;
     void HandleInput() override;
-    void Damage(const std::shared_ptr<Area>& area) override;
+    [[nodiscard]] HitShape GetHitShape() const override;
+    void OnHit(Monster& monster) override;
 
 private:
     bool exploding = false;
@@ -0,0 +1,67 @@
+#include "CollisionPhase.h"
+#include "EnemyProjectileSystem.h"
+#include "MagicStore.h"
+#include "Monster.h"
+#include "MonsterStore.h"
+#include "Player.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+
+void CollisionPhase::Run(MonsterStore& monsters, MagicStore& playerMagic,
+                         EnemyProjectileSystem& enemyProjectiles, Player* player)
+{
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float startTime = system->getElapsedTime();
+    stats = CollisionStats();
+    shapes.clear();
+    owners.clear();
+    pairs.clear();
+
+    // Broad phase, player magic against the monsters around each shape.
+    // Magic that died earlier in this tick still hits, as it did when it checked its own damage.
+    for (int magic = 0; magic < playerMagic.Size(); ++magic)
+    {
+        const HitShape shape = playerMagic.GetHitShape(magic);
+        if (shape.type == HitShape::Type::None) continue;
+
+        const int index = static_cast<int>(shapes.size());
+        shapes.push_back(shape);
+        owners.push_back(magic);
+        for (const int slot : monsters.GetCandidates(shape))
+        {
+            pairs.push_back({index, slot});
+        }
+    }
+    stats.shapes = static_cast<int>(shapes.size());
+    stats.candidatePairs = static_cast<int>(pairs.size());
+
+    // Narrow phase
+    const std::vector<pdcpp::Point<int>>& positions = monsters.GetPositions();
+    for (const CandidatePair& pair : pairs)
+    {
+        if (shapes[pair.shape].Contains(positions[pair.slot]))
+        {
+            playerMagic.OnHit(owners[pair.shape], *monsters.GetMonster(pair.slot));
+            stats.hits++;
+        }
+    }
+
+    // Enemy projectiles against the player
+    if (player != nullptr && player->IsAlive())
+    {
+        const pdcpp::Point<int> playerPosition = player->GetCenteredPosition();
+        // Backwards, since a hit removes the projectile by moving the last one into its index
+        for (int index = enemyProjectiles.Size() - 1; index >= 0; --index)
+        {
+            stats.shapes++;
+            stats.candidatePairs++;
+            if (enemyProjectiles.GetHitShape(index).Contains(playerPosition))
+            {
+                player->Damage(enemyProjectiles.GetDamage(index));
+                enemyProjectiles.Remove(index);
+                stats.hits++;
+            }
+        }
+    }
+
+    stats.timeUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+}
@@ -0,0 +1,56 @@
+#ifndef CARDOBLAST_COLLISIONPHASE_H
+#define CARDOBLAST_COLLISIONPHASE_H
+
+#include "HitShape.h"
+#include <memory>
+#include <vector>
+
+class EnemyProjectileSystem;
+class MagicStore;
+class MonsterStore;
+class Player;
+
+/**
+ * @brief Counters of the last collision phase.
+ */
+struct CollisionStats
+{
+    int shapes = 0;         ///< Projectiles with a hit shape this tick
+    int candidatePairs = 0; ///< Projectile/target pairs left by the broad phase
+    int hits = 0;           ///< Pairs that passed the narrow phase
+    int timeUs = 0;         ///< Time spent in the whole phase (microseconds)
+};
+
+/**
+ * @brief Resolves every projectile hit of a tick in one pass.
+ *
+ * Player magic is tested against the monsters: each hit shape gathers the monster slots of the
+ * grid cells it overlaps (broad phase) into a list of candidate pairs, and then every pair goes
+ * through the exact test of its shape against the store's packed positions (narrow phase)
+ * before Magic::OnHit runs.
+ * Enemy projectiles only have the player as target, so they're tested against it directly and
+ * removed when they hit.
+ *
+ * Buffers are reused between ticks.
+ */
+class CollisionPhase
+{
+public:
+    void Run(MonsterStore& monsters, MagicStore& playerMagic,
+             EnemyProjectileSystem& enemyProjectiles, Player* player);
+    [[nodiscard]] const CollisionStats& GetStats() const { return stats; }
+
+private:
+    struct CandidatePair
+    {
+        int shape; // index in shapes and owners
+        int slot; // in the MonsterStore
+    };
+
+    std::vector<HitShape> shapes;
+    std::vector<int> owners; // index in the MagicStore
+    std::vector<CandidatePair> pairs;
+    CollisionStats stats;
+};
+
+#endif //CARDOBLAST_COLLISIONPHASE_H
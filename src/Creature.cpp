@@ -42,6 +42,24 @@ Creature::Creature(Creature &&other) noexcept
     SetMovementScale(1); // Default movement scale for creatures, can be adjusted later
 }
 
+Creature& Creature::operator=(const Creature &other)
+{
+    if (this == &other) return *this;
+    Entity::operator=(other);
+    strength = other.GetStrength();
+    agility = other.GetAgility();
+    constitution = other.GetConstitution();
+    evasion = other.GetEvasion();
+    xp = other.GetXP();
+    weapon = other.weapon;
+    armor = other.armor;
+    inventory = nullptr; // not copied by the copy constructor either
+    equippedWeapon = nullptr;
+    equippedArmor = nullptr;
+    SetMovementScale(3); // Default movement scale for creatures, can be adjusted later
+    return *this;
+}
+
 int Creature::GetStrength() const {
     return strength;
 }
@@ -142,9 +160,4 @@ int Creature::TraverseDoor(Door *door) {
     return 0;
 }
 
-void Creature::Tick()
-{
-    Draw();
-}
-
 
@@ -31,6 +31,7 @@ public:
     Creature()=default;
     Creature(const Creature& other);
     Creature(Creature&& other) noexcept;
+    Creature& operator=(const Creature& other); // same rules as the copy constructor, used to recycle pooled monsters
     Creature(unsigned int _id, const std::string& _name, const std::string& _image, float _maxHp, int _strength, int _agility,
              int _constitution, float _evasion, unsigned int _xp, int weapon, int armor);
 
@@ -60,7 +61,6 @@ public:
 
     int Attack(Creature* target);
     int TraverseDoor(Door* door);
-    void Tick();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "DStarBenchmark.h"
+#include "DStarLite.h"
+#include "Globals.h"
+#include "Log.h"
+#include "MapCollision.h"
+#include "PathCosts.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/core/Random.h"
+#include <climits>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace
+{
+    constexpr int MAP_SIZE = Globals::DEFAULT_MAP_WIDTH;
+    constexpr int WALL_PERCENT = 20;
+    constexpr int BLOCKER_COUNT = 8;
+
+    pdcpp::Point<int> RandomWalkableTile(const MapCollision& collider, pdcpp::Random& random)
+    {
+        for (int attempt = 0; attempt < 1000; ++attempt)
+        {
+            const int x = static_cast<int>(random.next() % static_cast<unsigned int>(MAP_SIZE));
+            const int y = static_cast<int>(random.next() % static_cast<unsigned int>(MAP_SIZE));
+            if (collider.isStaticWalkable(x, y)) return {x, y};
+        }
+        return {MAP_SIZE / 2, MAP_SIZE / 2};
+    }
+
+    /**
+     * Cost from start to goal with the planner's rules: occupied tiles block except for the start
+     * and the goal, and diagonal steps can't cut a corner. Searched backwards from the goal like
+     * the planner. DStarLite::INFINITE_COST if there's no path.
+     */
+    unsigned int ReferenceCost(const MapCollision& collider, const pdcpp::Point<int> start, const pdcpp::Point<int> goal)
+    {
+        auto blocked = [&](const int x, const int y)
+        {
+            if (collider.isOutsideMap(x, y) || !collider.isStaticWalkable(x, y)) return true;
+            return collider.isTileOccupied(x, y) && !(x == start.x && y == start.y) && !(x == goal.x && y == goal.y);
+        };
+
+        std::vector<unsigned int> cost(static_cast<size_t>(MAP_SIZE) * MAP_SIZE, DStarLite::INFINITE_COST);
+        using Entry = std::pair<unsigned int, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        cost[goal.y * MAP_SIZE + goal.x] = 0;
+        open.push({0, goal.y * MAP_SIZE + goal.x});
+        while (!open.empty())
+        {
+            const auto [current, index] = open.top();
+            open.pop();
+            if (current != cost[index]) continue; // stale entry
+            const int x = index % MAP_SIZE;
+            const int y = index / MAP_SIZE;
+            if (x == start.x && y == start.y) return current;
+            if (blocked(x, y)) continue;
+
+            for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+            {
+                const int nx = x + PathCosts::NEIGHBOUR_DX[i];
+                const int ny = y + PathCosts::NEIGHBOUR_DY[i];
+                if (blocked(nx, ny)) continue;
+                const bool diagonal = PathCosts::NEIGHBOUR_DX[i] != 0 && PathCosts::NEIGHBOUR_DY[i] != 0;
+                if (diagonal && (blocked(x, ny) || blocked(nx, y))) continue;
+
+                const unsigned int next = current + (diagonal ? PathCosts::DIAGONAL_COST : PathCosts::STRAIGHT_COST);
+                if (next < cost[ny * MAP_SIZE + nx])
+                {
+                    cost[ny * MAP_SIZE + nx] = next;
+                    open.push({next, ny * MAP_SIZE + nx});
+                }
+            }
+        }
+        return DStarLite::INFINITE_COST;
+    }
+
+    // Cost of the path the planner would walk from its start, DStarLite::INFINITE_COST if it has none
+    unsigned int PlannedCost(const DStarLite& planner, std::vector<pdcpp::Point<int>>& path)
+    {
+        if (planner.GetStart() == planner.GetGoal()) return 0;
+        if (!planner.GetPathAhead(path, MAP_SIZE * MAP_SIZE) || !(path.front() == planner.GetGoal())) return DStarLite::INFINITE_COST;
+
+        unsigned int cost = 0;
+        pdcpp::Point<int> previous = planner.GetStart();
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+        {
+            cost += (it->x != previous.x && it->y != previous.y) ? PathCosts::DIAGONAL_COST : PathCosts::STRAIGHT_COST;
+            previous = *it;
+        }
+        return cost;
+    }
+
+    void RunScenario(const char* name, const bool wanderingTarget, pdcpp::Random& random)
+    {
+        auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+
+        Map_Layer layer(static_cast<size_t>(MAP_SIZE) * MAP_SIZE, MapCollision::BLOCKS_NONE);
+        for (auto& tile : layer)
+        {
+            if (random.next() % 100 < WALL_PERCENT) tile = MapCollision::BLOCKS_ALL;
+        }
+        MapCollision collider;
+        collider.SetMap(layer, MAP_SIZE, MAP_SIZE);
+
+        std::vector<pdcpp::Point<int>> blockers;
+        for (int i = 0; i < BLOCKER_COUNT; ++i)
+        {
+            blockers.push_back(RandomWalkableTile(collider, random));
+            collider.block(static_cast<float>(blockers.back().x), static_cast<float>(blockers.back().y), false);
+        }
+
+        DStarLite planner;
+        DStarLite fresh;
+        std::vector<pdcpp::Point<int>> path;
+        pdcpp::Point<int> start = RandomWalkableTile(collider, random);
+        pdcpp::Point<int> target = RandomWalkableTile(collider, random);
+        int mismatches = 0;
+        unsigned int expanded = 0;
+        unsigned int freshExpanded = 0;
+        float plannerTime = 0.0f;
+        float freshTime = 0.0f;
+
+        for (int step = 0; step < Globals::DSTAR_BENCHMARK_STEPS; ++step)
+        {
+            float startTime = system->getElapsedTime();
+            planner.Update(&collider, start, target, UINT_MAX);
+            plannerTime += system->getElapsedTime() - startTime;
+            expanded += planner.GetLastExpandedCount();
+
+            // The planner may keep a goal that drifted, the fresh search uses the same one
+            startTime = system->getElapsedTime();
+            fresh.Reset();
+            fresh.Update(&collider, start, planner.GetGoal(), UINT_MAX);
+            freshTime += system->getElapsedTime() - startTime;
+            freshExpanded += fresh.GetLastExpandedCount();
+
+            if (PlannedCost(planner, path) != ReferenceCost(collider, start, planner.GetGoal())) mismatches++;
+
+            // Walk one step, or start over somewhere else once there's nothing to walk
+            pdcpp::Point<int> next = {0, 0};
+            if (planner.GetNextStep(next))
+            {
+                start = next;
+            }
+            else
+            {
+                start = RandomWalkableTile(collider, random);
+                target = RandomWalkableTile(collider, random);
+            }
+            if (wanderingTarget)
+            {
+                const int i = static_cast<int>(random.next() % PathCosts::NEIGHBOUR_COUNT);
+                const int nx = target.x + PathCosts::NEIGHBOUR_DX[i];
+                const int ny = target.y + PathCosts::NEIGHBOUR_DY[i];
+                if (!collider.isOutsideMap(nx, ny) && collider.isStaticWalkable(nx, ny)) target = {nx, ny};
+            }
+
+            // One blocker hops somewhere else, the planner picks it up from the tile change log
+            pdcpp::Point<int>& blocker = blockers[step % BLOCKER_COUNT];
+            collider.unblock(static_cast<float>(blocker.x), static_cast<float>(blocker.y), false);
+            blocker = RandomWalkableTile(collider, random);
+            collider.block(static_cast<float>(blocker.x), static_cast<float>(blocker.y), false);
+        }
+
+        const float updates = static_cast<float>(Globals::DSTAR_BENCHMARK_STEPS);
+        Log::Info("D* Lite benchmark %s: %d updates, %d cost mismatches, %f expanded per update (fresh search %f), %d us (fresh search %d us)",
+                  name, Globals::DSTAR_BENCHMARK_STEPS, mismatches,
+                  static_cast<float>(expanded) / updates, static_cast<float>(freshExpanded) / updates,
+                  static_cast<int>(plannerTime * 1000000.0f), static_cast<int>(freshTime * 1000000.0f));
+    }
+}
+
+void DStarBenchmark::Run()
+{
+    pdcpp::Random random;
+    RunScenario("fixed target", false, random);
+    RunScenario("wandering target", true, random);
+}
@@ -0,0 +1,19 @@
+#ifndef CARDOBLAST_DSTARBENCHMARK_H
+#define CARDOBLAST_DSTARBENCHMARK_H
+
+/**
+ * @brief Development check of the D* Lite planner against a from-scratch search.
+ *
+ * A monster walks its planner's path on a random map while blockers hop around it, once
+ * towards a fixed target and once towards a wandering one. After every repair the cost of the
+ * planned path is compared with a Dijkstra search done from scratch with the same rules, and
+ * the tiles expanded by the repair are compared with a fresh planner's. Logs the mismatches,
+ * the expansions per update and the time of both. Only runs when
+ * Globals::RUN_DSTAR_BENCHMARK is enabled.
+ */
+namespace DStarBenchmark
+{
+    void Run();
+}
+
+#endif //CARDOBLAST_DSTARBENCHMARK_H
@@ -0,0 +1,317 @@
+#include "DStarLite.h"
+#include "Globals.h"
+#include "MapCollision.h"
+#include "PathCosts.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+bool DStarLite::Update(const MapCollision* collider, const pdcpp::Point<int> newStart, const pdcpp::Point<int> newGoal,
+                       const unsigned int expansionLimit)
+{
+    if (collider == nullptr || collider->isOutsideMap(newStart.x, newStart.y) || collider->isOutsideMap(newGoal.x, newGoal.y))
+    {
+        return false;
+    }
+    lastExpanded = 0;
+
+    if (!initialized || staticVersion != collider->getStaticVersion())
+    {
+        start = newStart;
+        goal = newGoal;
+        Initialize(collider);
+    }
+    else
+    {
+        SyncOccupancy(collider);
+
+        if (!(newStart == start))
+        {
+            // Moving the start only shifts the heuristic, queued keys are corrected lazily.
+            // The start tile is never an obstacle, so both tiles may change cost.
+            keyModifier += PathCosts::OctileDistance(lastStart.x, lastStart.y, newStart.x, newStart.y);
+            const pdcpp::Point<int> oldStart = start;
+            lastStart = newStart;
+            start = newStart;
+            UpdateAround(oldStart.x, oldStart.y);
+            UpdateAround(start.x, start.y);
+        }
+        if (!(newGoal == goal) && ShouldMoveGoal(newGoal))
+        {
+            // The old goal loses its zero cost and the new one gains it, the rest is repaired by the search
+            const pdcpp::Point<int> oldGoal = goal;
+            goal = newGoal;
+            rhs[ToIndex(goal)] = 0;
+            UpdateAround(oldGoal.x, oldGoal.y);
+            UpdateAround(goal.x, goal.y);
+        }
+    }
+
+    ComputeShortestPath(expansionLimit);
+    return g[ToIndex(start)] < INFINITE_COST;
+}
+
+bool DStarLite::GetStepFrom(const pdcpp::Point<int> from, pdcpp::Point<int>& next) const
+{
+    if (!initialized || from == goal || g[ToIndex(from)] >= INFINITE_COST) return false;
+
+    unsigned int best = INFINITE_COST;
+    for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+    {
+        const int nx = from.x + PathCosts::NEIGHBOUR_DX[i];
+        const int ny = from.y + PathCosts::NEIGHBOUR_DY[i];
+        const unsigned int cost = GetCost(from.x, from.y, nx, ny);
+        if (cost >= INFINITE_COST) continue;
+
+        const unsigned int total = cost + g[ny * width + nx];
+        if (total < best)
+        {
+            best = total;
+            next = {nx, ny};
+        }
+    }
+    return best < INFINITE_COST;
+}
+
+bool DStarLite::GetPathAhead(std::vector<pdcpp::Point<int>>& path, const int maxSteps) const
+{
+    path.clear();
+    pdcpp::Point<int> position = start;
+    pdcpp::Point<int> next = {0, 0};
+    // Each step lowers g while the search is consistent, maxSteps also bounds it while it isn't
+    while (static_cast<int>(path.size()) < maxSteps && GetStepFrom(position, next))
+    {
+        path.push_back(next);
+        position = next;
+    }
+    std::reverse(path.begin(), path.end());
+    return !path.empty();
+}
+
+bool DStarLite::ShouldMoveGoal(const pdcpp::Point<int> newGoal) const
+{
+    // Moving the goal shifts the cost of the whole search tree, so it costs about as much as a
+    // fresh search. While the monster is far away, a target that only wandered a few tiles keeps
+    // the old goal: the route there is almost the same. Close to the target we follow it exactly.
+    const int drift = std::max(std::abs(newGoal.x - goal.x), std::abs(newGoal.y - goal.y));
+    const int remaining = std::max(std::abs(newGoal.x - start.x), std::abs(newGoal.y - start.y));
+    return drift > Globals::DSTAR_GOAL_DRIFT || remaining <= Globals::DSTAR_GOAL_DRIFT * 2;
+}
+
+void DStarLite::Initialize(const MapCollision* collider)
+{
+    width = collider->map_size.x;
+    height = collider->map_size.y;
+    const size_t tileCount = static_cast<size_t>(width) * height;
+
+    g.assign(tileCount, INFINITE_COST);
+    rhs.assign(tileCount, INFINITE_COST);
+    queuedKey.assign(tileCount, {0, 0});
+    inQueue.assign(tileCount, 0);
+    walkable.assign(tileCount, 0);
+    occupied.assign(tileCount, 0);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            walkable[y * width + x] = collider->isStaticWalkable(x, y) ? 1 : 0;
+            occupied[y * width + x] = collider->isTileOccupied(x, y) ? 1 : 0;
+        }
+    }
+
+    queue.clear();
+    keyModifier = 0;
+    lastStart = start;
+    staticVersion = collider->getStaticVersion();
+    lastChange = collider->getTileChangeCount();
+    initialized = true;
+    initializations++;
+
+    rhs[ToIndex(goal)] = 0;
+    Push(ToIndex(goal));
+}
+
+void DStarLite::SyncOccupancy(const MapCollision* collider)
+{
+    const unsigned int changeCount = collider->getTileChangeCount();
+    pdcpp::Point<int> tile = {0, 0};
+    for (; lastChange != changeCount; ++lastChange)
+    {
+        if (!collider->getTileChange(lastChange, tile))
+        {
+            // We fell behind the change log, compare the whole map instead
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    SetOccupied(x, y, collider->isTileOccupied(x, y));
+                }
+            }
+            lastChange = changeCount;
+            return;
+        }
+        SetOccupied(tile.x, tile.y, collider->isTileOccupied(tile.x, tile.y));
+    }
+}
+
+void DStarLite::SetOccupied(const int x, const int y, const bool value)
+{
+    const int index = y * width + x;
+    if ((occupied[index] != 0) == value) return;
+    occupied[index] = value ? 1 : 0;
+    UpdateAround(x, y);
+}
+
+void DStarLite::ComputeShortestPath(const unsigned int expansionLimit)
+{
+    const int startIndex = ToIndex(start);
+    QueueEntry top {};
+    searchComplete = true;
+    while (PeekTop(top) && (top.key < CalculateKey(startIndex) || rhs[startIndex] != g[startIndex]))
+    {
+        // Unfinished work stays queued and is picked up by the next Update
+        if (lastExpanded >= expansionLimit)
+        {
+            searchComplete = false;
+            break;
+        }
+
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        queue.pop_back();
+
+        const int u = top.index;
+        if (top.key < CalculateKey(u))
+        {
+            Push(u); // outdated by a start move
+            continue;
+        }
+        lastExpanded++;
+        inQueue[u] = 0;
+
+        if (g[u] > rhs[u])
+        {
+            g[u] = rhs[u];
+        }
+        else
+        {
+            g[u] = INFINITE_COST;
+            UpdateVertex(u);
+        }
+
+        const int ux = u % width;
+        const int uy = u / width;
+        for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+        {
+            const int nx = ux + PathCosts::NEIGHBOUR_DX[i];
+            const int ny = uy + PathCosts::NEIGHBOUR_DY[i];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            UpdateVertex(ny * width + nx);
+        }
+    }
+}
+
+DStarLite::Key DStarLite::CalculateKey(const int index) const
+{
+    const unsigned int cost = std::min(g[index], rhs[index]);
+    return {cost + Heuristic(index) + keyModifier, cost};
+}
+
+void DStarLite::UpdateVertex(const int index)
+{
+    if (index != ToIndex(goal))
+    {
+        const int x = index % width;
+        const int y = index / width;
+        unsigned int best = INFINITE_COST;
+        for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+        {
+            const int nx = x + PathCosts::NEIGHBOUR_DX[i];
+            const int ny = y + PathCosts::NEIGHBOUR_DY[i];
+            const unsigned int cost = GetCost(x, y, nx, ny);
+            if (cost >= INFINITE_COST) continue;
+
+            const unsigned int neighbourCost = g[ny * width + nx];
+            if (neighbourCost < INFINITE_COST)
+            {
+                best = std::min(best, cost + neighbourCost);
+            }
+        }
+        rhs[index] = best;
+    }
+
+    if (g[index] != rhs[index])
+    {
+        Push(index);
+    }
+    else
+    {
+        inQueue[index] = 0;
+    }
+}
+
+void DStarLite::UpdateAround(const int x, const int y)
+{
+    // A tile change affects its own edges and the diagonals cutting its corner,
+    // all of which start inside this 3x3 block
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            UpdateVertex(ny * width + nx);
+        }
+    }
+}
+
+void DStarLite::Push(const int index)
+{
+    const Key key = CalculateKey(index);
+    queuedKey[index] = key;
+    inQueue[index] = 1;
+    queue.push_back({key, index});
+    std::push_heap(queue.begin(), queue.end(), std::greater<>());
+}
+
+bool DStarLite::PeekTop(QueueEntry& top)
+{
+    // Drop entries that were removed or re-queued with another key since they were pushed
+    while (!queue.empty())
+    {
+        const QueueEntry& front = queue.front();
+        if (inQueue[front.index] && queuedKey[front.index] == front.key)
+        {
+            top = front;
+            return true;
+        }
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        queue.pop_back();
+    }
+    return false;
+}
+
+bool DStarLite::IsBlocked(const int x, const int y) const
+{
+    if (x < 0 || y < 0 || x >= width || y >= height) return true;
+    const int index = y * width + x;
+    if (!walkable[index]) return true;
+    return occupied[index] && !(x == goal.x && y == goal.y) && !(x == start.x && y == start.y);
+}
+
+unsigned int DStarLite::GetCost(const int fromX, const int fromY, const int toX, const int toY) const
+{
+    if (IsBlocked(fromX, fromY) || IsBlocked(toX, toY)) return INFINITE_COST;
+    if (fromX != toX && fromY != toY)
+    {
+        // no corner cutting
+        if (IsBlocked(fromX, toY) || IsBlocked(toX, fromY)) return INFINITE_COST;
+        return PathCosts::DIAGONAL_COST;
+    }
+    return PathCosts::STRAIGHT_COST;
+}
+
+unsigned int DStarLite::Heuristic(const int index) const
+{
+    return PathCosts::OctileDistance(start.x, start.y, index % width, index / width);
+}
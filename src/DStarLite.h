@@ -0,0 +1,125 @@
+#ifndef CARDOBLAST_DSTARLITE_H
+#define CARDOBLAST_DSTARLITE_H
+
+#include "Globals.h"
+#include "pdcpp/graphics/Point.h"
+#include <vector>
+
+class MapCollision;
+
+/**
+ * @brief D* Lite planner of a single chasing monster, kept for it by the area's MonsterStore.
+ *
+ * The search runs backwards from the goal, so when the monster (start) walks along the
+ * path nothing has to be recomputed. When the goal moves, or MapCollision::block/unblock
+ * changes a tile the planner knows about, only the affected part of the search tree is
+ * repaired instead of starting from scratch.
+ *
+ * Buffers are allocated on the first Update, so monsters that never plan pay nothing. They
+ * take about 19 bytes per tile, see Globals::DSTAR_MAX_MAP_TILES.
+ * Tiles occupied by other entities are obstacles, except for the start and goal tiles.
+ */
+class DStarLite
+{
+public:
+    static constexpr unsigned int INFINITE_COST = 0x3FFFFFFF;
+
+    DStarLite() = default;
+
+    /**
+     * @brief Move the start and goal and repair the search.
+     *
+     * At most `expansionLimit` tiles are expanded. If the search isn't complete, calling
+     * Update again resumes it where it stopped.
+     * @return true if there's a known path from start to goal
+     */
+    bool Update(const MapCollision* collider, pdcpp::Point<int> start, pdcpp::Point<int> goal,
+                unsigned int expansionLimit = Globals::DSTAR_MAX_EXPANSIONS_PER_UPDATE);
+    [[nodiscard]] bool IsSearchComplete() const { return searchComplete; }
+
+    /**
+     * @brief Goal the search is currently rooted at.
+     *
+     * It lags behind the requested goal by up to Globals::DSTAR_GOAL_DRIFT tiles while the start is far from it.
+     */
+    [[nodiscard]] pdcpp::Point<int> GetGoal() const { return goal; }
+    [[nodiscard]] pdcpp::Point<int> GetStart() const { return start; }
+
+    /**
+     * @brief Best tile to step on from the current start.
+     * @return false if the goal is unreachable or already reached
+     */
+    bool GetNextStep(pdcpp::Point<int>& next) const { return GetStepFrom(start, next); }
+
+    /**
+     * @brief The first `maxSteps` tiles of the path from the current start, in ComputePath's order (end first).
+     *
+     * Meant for MapCollision::smoothPath, which needs more than the next step to skip turns.
+     * @return false if there's no next step
+     */
+    bool GetPathAhead(std::vector<pdcpp::Point<int>>& path, int maxSteps) const;
+
+    void Reset() { initialized = false; }
+    [[nodiscard]] unsigned int GetLastExpandedCount() const { return lastExpanded; }
+    [[nodiscard]] unsigned int GetInitializationCount() const { return initializations; }
+
+private:
+    struct Key
+    {
+        unsigned int primary;
+        unsigned int secondary;
+        bool operator<(const Key& other) const
+        {
+            return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+        }
+        bool operator==(const Key& other) const { return primary == other.primary && secondary == other.secondary; }
+    };
+
+    struct QueueEntry
+    {
+        Key key;
+        int index;
+        bool operator>(const QueueEntry& other) const { return other.key < key; }
+    };
+
+    [[nodiscard]] bool ShouldMoveGoal(pdcpp::Point<int> newGoal) const;
+    bool GetStepFrom(pdcpp::Point<int> from, pdcpp::Point<int>& next) const;
+    void Initialize(const MapCollision* collider);
+    void SyncOccupancy(const MapCollision* collider);
+    void SetOccupied(int x, int y, bool value);
+    void ComputeShortestPath(unsigned int expansionLimit);
+
+    [[nodiscard]] Key CalculateKey(int index) const;
+    void UpdateVertex(int index);
+    void UpdateAround(int x, int y);
+    void Push(int index);
+    bool PeekTop(QueueEntry& top);
+
+    [[nodiscard]] bool IsBlocked(int x, int y) const;
+    [[nodiscard]] unsigned int GetCost(int fromX, int fromY, int toX, int toY) const;
+    [[nodiscard]] unsigned int Heuristic(int index) const;
+    [[nodiscard]] int ToIndex(const pdcpp::Point<int>& position) const { return position.y * width + position.x; }
+
+    std::vector<unsigned int> g;
+    std::vector<unsigned int> rhs;
+    std::vector<Key> queuedKey; // key of the live queue entry of each tile
+    std::vector<unsigned char> inQueue;
+    std::vector<unsigned char> walkable; // static layer
+    std::vector<unsigned char> occupied; // entities, as last seen in the collider
+    std::vector<QueueEntry> queue; // binary heap, outdated entries are skipped when popped
+
+    pdcpp::Point<int> start = {0, 0};
+    pdcpp::Point<int> goal = {0, 0};
+    pdcpp::Point<int> lastStart = {0, 0};
+    unsigned int keyModifier = 0; // km in the paper, grows as the start moves
+    int width = 0;
+    int height = 0;
+    unsigned int staticVersion = 0;
+    unsigned int lastChange = 0; // next MapCollision tile change to read
+    unsigned int lastExpanded = 0;
+    unsigned int initializations = 0;
+    bool initialized = false;
+    bool searchComplete = false;
+};
+
+#endif //CARDOBLAST_DSTARLITE_H
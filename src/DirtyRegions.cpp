@@ -0,0 +1,64 @@
+#include "DirtyRegions.h"
+#include "UIConstants.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include <algorithm>
+
+void DirtyRegions::MarkDirty(const pdcpp::Rectangle<int>& region)
+{
+    // Clamp to the screen
+    const int left = std::max(0, region.x);
+    const int top = std::max(0, region.y);
+    const int right = std::min(UIConstants::SCREEN_WIDTH, region.getRight());
+    const int bottom = std::min(UIConstants::SCREEN_HEIGHT, region.getBottom());
+    if (right <= left || bottom <= top) return;
+
+    if (dirtyRects == 0)
+    {
+        bounds = {left, top, right - left, bottom - top};
+    }
+    else
+    {
+        const int mergedLeft = std::min(bounds.x, left);
+        const int mergedTop = std::min(bounds.y, top);
+        bounds = {mergedLeft, mergedTop, std::max(bounds.getRight(), right) - mergedLeft, std::max(bounds.getBottom(), bottom) - mergedTop};
+    }
+    dirtyRects++;
+}
+
+void DirtyRegions::MarkAll()
+{
+    MarkDirty({0, 0, UIConstants::SCREEN_WIDTH, UIConstants::SCREEN_HEIGHT});
+    fullRedraw = true;
+}
+
+bool DirtyRegions::Begin(const LCDColor clearColor, const pdcpp::Point<int> drawOffset)
+{
+    stats = ScreenUpdateStats();
+    stats.dirtyRects = dirtyRects;
+    if (IsEmpty()) return false;
+
+    auto* pd = pdcpp::GlobalPlaydateAPI::get();
+    startTime = pd->system->getElapsedTime();
+    stats.fullRedraw = fullRedraw;
+    stats.redrawnRows = bounds.height;
+    if (fullRedraw)
+    {
+        pd->graphics->clear(clearColor);
+        return true;
+    }
+
+    // The clip is in screen coordinates, the fill goes through the draw offset
+    pd->graphics->setScreenClipRect(bounds.x, bounds.y, bounds.width, bounds.height);
+    pd->graphics->fillRect(bounds.x - drawOffset.x, bounds.y - drawOffset.y, bounds.width, bounds.height, clearColor);
+    return true;
+}
+
+void DirtyRegions::End()
+{
+    auto* pd = pdcpp::GlobalPlaydateAPI::get();
+    if (!fullRedraw) pd->graphics->clearClipRect();
+    stats.timeUs = static_cast<int>((pd->system->getElapsedTime() - startTime) * 1000000.0f);
+
+    dirtyRects = 0;
+    fullRedraw = false;
+}
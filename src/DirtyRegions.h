@@ -0,0 +1,59 @@
+#ifndef CARDOBLAST_DIRTYREGIONS_H
+#define CARDOBLAST_DIRTYREGIONS_H
+
+#include "pd_api.h"
+#include "pdcpp/graphics/Point.h"
+#include "pdcpp/graphics/Rectangle.h"
+
+/**
+ * @brief Counters of the last frame drawn through DirtyRegions.
+ */
+struct ScreenUpdateStats
+{
+    int dirtyRects = 0;   ///< Regions marked dirty this frame
+    int redrawnRows = 0;  ///< Screen rows redrawn, and so flushed to the display
+    bool fullRedraw = false;
+    int timeUs = 0;       ///< Time spent redrawing (microseconds)
+};
+
+/**
+ * @brief Screen regions that changed since the last frame.
+ *
+ * The frame buffer keeps its content between frames, and the display only receives the rows
+ * that were drawn into. Screens that barely change (menus, loading, the game while the camera
+ * holds still) mark the regions whose content changed, and the frame is redrawn clipped to
+ * their bounds instead of cleared and redrawn whole. When nothing is dirty, nothing is drawn
+ * and no row is flushed.
+ *
+ * Regions are in screen coordinates. Marked regions are merged into one bounding rectangle,
+ * since the display can only clip to one.
+ */
+class DirtyRegions
+{
+public:
+    void MarkDirty(const pdcpp::Rectangle<int>& region);
+    // Redraw the whole screen this frame
+    void MarkAll();
+    [[nodiscard]] bool IsEmpty() const { return dirtyRects == 0; }
+
+    /**
+     * @brief Clear the dirty bounds to `clearColor` and clip drawing to them.
+     *
+     * `drawOffset` is the graphics draw offset the frame is drawn with.
+     * @return false if nothing is dirty, and then the frame must not be drawn
+     */
+    bool Begin(LCDColor clearColor, pdcpp::Point<int> drawOffset = {0, 0});
+    // Remove the clip and start tracking the next frame
+    void End();
+
+    [[nodiscard]] const ScreenUpdateStats& GetStats() const { return stats; }
+
+private:
+    pdcpp::Rectangle<int> bounds;
+    int dirtyRects = 0;
+    bool fullRedraw = false;
+    float startTime = 0.0f;
+    ScreenUpdateStats stats;
+};
+
+#endif //CARDOBLAST_DIRTYREGIONS_H
@@ -0,0 +1,154 @@
+#include "DrawList.h"
+#include "DirtyRegions.h"
+#include "EnemyProjectileSystem.h"
+#include "Entity.h"
+#include "Globals.h"
+#include "MagicStore.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include <algorithm>
+
+DrawList::DrawList()
+{
+    commands.reserve(Globals::DRAW_LIST_CAPACITY);
+    bounds.reserve(Globals::DRAW_LIST_CAPACITY);
+    drawnBounds.reserve(Globals::DRAW_LIST_CAPACITY);
+}
+
+void DrawList::Begin(const pdcpp::Rectangle<int>& _camera)
+{
+    commands.clear();
+    bounds.swap(drawnBounds);
+    bounds.clear();
+    drawnUnbounded = unbounded;
+    unbounded = false;
+    camera = _camera;
+    enemyProjectiles = nullptr;
+    playerMagic = nullptr;
+    stats = DrawListStats();
+}
+
+bool DrawList::IsVisible(const pdcpp::Point<int> position)
+{
+    const bool visible = position.x > camera.x && position.x < camera.getRight() &&
+                         position.y > camera.y && position.y < camera.getBottom();
+    if (!visible) stats.culled++;
+    return visible;
+}
+
+void DrawList::SubmitEntity(const Layer layer, const Type type, const int sortY, Entity* entity)
+{
+    Push({sortY, layer, type, 0, entity, 0});
+
+    const pdcpp::Point<int> position = entity->GetPosition();
+    AddBounds({position.x - Globals::DRAW_BOUNDS_MARGIN, position.y - Globals::DRAW_BOUNDS_MARGIN,
+               2 * Globals::DRAW_BOUNDS_MARGIN, 2 * Globals::DRAW_BOUNDS_MARGIN});
+}
+
+void DrawList::SubmitEnemyProjectile(const EnemyProjectileSystem& system, const int index, const int sortY)
+{
+    enemyProjectiles = &system;
+    Push({sortY, Layer::Projectiles, Type::EnemyProjectile, 0, nullptr, index});
+
+    const pdcpp::Point<int> position = system.GetPosition(index);
+    AddBounds({position.x, position.y, system.GetSize(index) + 1, system.GetSize(index) + 1});
+}
+
+void DrawList::SubmitPlayerMagic(const MagicStore& store)
+{
+    // The spells are drawn as one command, they all follow the player
+    playerMagic = &store;
+    Push({0, Layer::Projectiles, Type::PlayerMagic, 0, nullptr, 0});
+    // Beams and orbits reach far from the player and have no draw bounds
+    if (store.Size() > 0) unbounded = true;
+}
+
+void DrawList::Push(const Command& command)
+{
+    if (static_cast<int>(commands.size()) >= Globals::DRAW_LIST_CAPACITY)
+    {
+        stats.dropped++;
+        return;
+    }
+    commands.push_back(command);
+    commands.back().order = static_cast<unsigned short>(commands.size());
+    stats.submitted++;
+}
+
+void DrawList::AddBounds(const pdcpp::Rectangle<int>& rectangle)
+{
+    // An entity submits a few commands in a row, all in the same rectangle
+    if (!bounds.empty() && bounds.back().x == rectangle.x && bounds.back().y == rectangle.y &&
+        bounds.back().width == rectangle.width && bounds.back().height == rectangle.height)
+    {
+        return;
+    }
+    bounds.push_back(rectangle);
+}
+
+bool DrawList::MarkDirtyRegions(DirtyRegions& regions, const pdcpp::Point<int> drawOffset) const
+{
+    if (unbounded || drawnUnbounded) return false;
+    for (const auto* frame : {&drawnBounds, &bounds})
+    {
+        for (const auto& rectangle : *frame)
+        {
+            regions.MarkDirty({rectangle.x + drawOffset.x, rectangle.y + drawOffset.y, rectangle.width, rectangle.height});
+        }
+    }
+    return true;
+}
+
+void DrawList::Execute()
+{
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float startTime = system->getElapsedTime();
+
+    // Sprites sort by their feet. On the other layers the key only groups commands of the same type.
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b)
+    {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.layer != Layer::Sprites && a.type != b.type) return a.type < b.type;
+        if (a.sortY != b.sortY) return a.sortY < b.sortY;
+        return a.order < b.order;
+    });
+
+    size_t begin = 0;
+    while (begin < commands.size())
+    {
+        size_t end = begin + 1;
+        while (end < commands.size() && commands[end].layer == commands[begin].layer && commands[end].type == commands[begin].type)
+        {
+            ++end;
+        }
+        ExecuteBatch(begin, end);
+        stats.batches++;
+        begin = end;
+    }
+
+    stats.timeUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+}
+
+void DrawList::ExecuteBatch(const size_t begin, const size_t end)
+{
+    switch (commands[begin].type)
+    {
+        case Type::EntityBody:
+            for (size_t i = begin; i < end; ++i) commands[i].entity->DrawBody();
+            break;
+        case Type::EntityEffects:
+            for (size_t i = begin; i < end; ++i) commands[i].entity->DrawEffects();
+            break;
+        case Type::EntityDeath:
+            for (size_t i = begin; i < end; ++i) commands[i].entity->DrawDeath();
+            break;
+        case Type::EntityOverlay:
+            for (size_t i = begin; i < end; ++i) commands[i].entity->DrawOverlay();
+            break;
+        case Type::EnemyProjectile:
+            for (size_t i = begin; i < end; ++i) enemyProjectiles->Draw(commands[i].index);
+            break;
+        case Type::PlayerMagic:
+            playerMagic->Draw();
+            break;
+    }
+}
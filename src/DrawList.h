@@ -0,0 +1,112 @@
+#ifndef CARDOBLAST_DRAWLIST_H
+#define CARDOBLAST_DRAWLIST_H
+
+#include "pdcpp/graphics/Point.h"
+#include "pdcpp/graphics/Rectangle.h"
+#include <vector>
+
+class DirtyRegions;
+class EnemyProjectileSystem;
+class Entity;
+class MagicStore;
+
+/**
+ * @brief Counters of the last executed draw list.
+ */
+struct DrawListStats
+{
+    int submitted = 0; ///< Commands submitted this frame
+    int culled = 0;    ///< Objects outside the camera rectangle, which submitted nothing
+    int dropped = 0;   ///< Commands refused because the list was full
+    int batches = 0;   ///< Runs of commands of the same layer and type
+    int timeUs = 0;    ///< Time spent sorting and executing (microseconds)
+};
+
+/**
+ * @brief Per-frame list of the world objects to draw on top of the map.
+ *
+ * Monsters, the player and the projectiles don't draw themselves anymore. They submit small
+ * commands (a type, a sort key and the object) once they passed culling against the camera
+ * rectangle, and Execute sorts them and runs them in batches of the same type.
+ *
+ * Sprites are sorted by the y of their feet, so whoever stands lower on screen is drawn in
+ * front. Projectiles, effects and overlays (health bars, aim arrow) go on layers above them.
+ * The list holds at most Globals::DRAW_LIST_CAPACITY commands, which caps the draw cost of
+ * a frame; commands past that are dropped and counted.
+ *
+ * Every submitted object also leaves the rectangle it draws in, and the rectangles of the
+ * previous frame are kept, so a frame whose camera didn't move can redraw only the screen
+ * regions objects moved in or out of (see MarkDirtyRegions).
+ */
+class DrawList
+{
+public:
+    enum class Layer : unsigned char
+    {
+        Sprites,     ///< Monsters and the player, sorted by the y of their feet
+        Projectiles, ///< Enemy projectiles and player magic
+        Effects,     ///< Sparks, damage numbers and death animations
+        Overlay      ///< Health bars and the aim arrow, always on top
+    };
+
+    enum class Type : unsigned char
+    {
+        EntityBody,
+        EntityEffects,
+        EntityDeath,
+        EntityOverlay,
+        EnemyProjectile,
+        PlayerMagic
+    };
+
+    DrawList();
+
+    // Start a frame, culling against `camera` (world pixels)
+    void Begin(const pdcpp::Rectangle<int>& camera);
+    // Culling test, made once per object before it submits. Counts the culled ones.
+    bool IsVisible(pdcpp::Point<int> position);
+
+    void SubmitEntity(Layer layer, Type type, int sortY, Entity* entity);
+    void SubmitEnemyProjectile(const EnemyProjectileSystem& system, int index, int sortY);
+    void SubmitPlayerMagic(const MagicStore& store);
+
+    // Sort the commands and draw them
+    void Execute();
+
+    /**
+     * @brief Mark where the objects of this frame and of the previous one draw.
+     *
+     * `drawOffset` is the graphics draw offset, the same for both frames.
+     * @return false if something of unknown extent is drawn (player magic), and then the whole screen must be redrawn
+     */
+    bool MarkDirtyRegions(DirtyRegions& regions, pdcpp::Point<int> drawOffset) const;
+
+    [[nodiscard]] const DrawListStats& GetStats() const { return stats; }
+
+private:
+    struct Command
+    {
+        int sortY;
+        Layer layer;
+        Type type;
+        unsigned short order; // submission order, keeps equal keys stable
+        Entity* entity;
+        int index; // enemy projectile index
+    };
+
+    void Push(const Command& command);
+    void AddBounds(const pdcpp::Rectangle<int>& rectangle);
+    void ExecuteBatch(size_t begin, size_t end);
+
+    std::vector<Command> commands;
+    std::vector<pdcpp::Rectangle<int>> bounds;      // world pixels drawn by this frame's objects
+    std::vector<pdcpp::Rectangle<int>> drawnBounds; // and by the previous frame's
+    bool unbounded = false;                         // something of unknown extent was submitted this frame
+    bool drawnUnbounded = false;
+    pdcpp::Rectangle<int> camera;
+    const EnemyProjectileSystem* enemyProjectiles = nullptr;
+    const MagicStore* playerMagic = nullptr;
+    DrawListStats stats;
+};
+
+#endif //CARDOBLAST_DRAWLIST_H
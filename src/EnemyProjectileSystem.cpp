@@ -0,0 +1,112 @@
+#include "EnemyProjectileSystem.h"
+#include "Globals.h"
+#include "MapCollision.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include <algorithm>
+#include <cmath>
+
+EnemyProjectileSystem::EnemyProjectileSystem()
+{
+    positions.reserve(Globals::ENEMY_PROJECTILE_CAPACITY);
+    velocities.reserve(Globals::ENEMY_PROJECTILE_CAPACITY);
+    sizes.reserve(Globals::ENEMY_PROJECTILE_CAPACITY);
+    damages.reserve(Globals::ENEMY_PROJECTILE_CAPACITY);
+    bornTimes.reserve(Globals::ENEMY_PROJECTILE_CAPACITY);
+}
+
+bool EnemyProjectileSystem::Fire(const pdcpp::Point<int> position, const float angle, const float speed,
+                                 const unsigned int size, const float damage, const unsigned int currentTime)
+{
+    if (Size() >= Globals::ENEMY_PROJECTILE_CAPACITY)
+    {
+        dropped++;
+        return false;
+    }
+
+    positions.push_back(position);
+    // Truncated once here, moving by the truncated step every tick as the projectiles always did
+    velocities.push_back({static_cast<int>(std::cos(angle) * speed), static_cast<int>(std::sin(angle) * speed)});
+    sizes.push_back(static_cast<unsigned char>(std::min(size, 255u)));
+    damages.push_back(damage);
+    bornTimes.push_back(currentTime);
+    return true;
+}
+
+void EnemyProjectileSystem::Update(const MapCollision* collider, const unsigned int currentTime)
+{
+    for (int index = 0; index < Size();)
+    {
+        positions[index].x += velocities[index].x;
+        positions[index].y += velocities[index].y;
+
+        if (currentTime - bornTimes[index] > Globals::MONSTER_PROJECTILE_LIFETIME)
+        {
+            Remove(index);
+            continue;
+        }
+
+        // Walls stop the projectile. Only the static layer is read, monsters don't block shots.
+        const pdcpp::Point<int> center = GetCenter(index);
+        if (collider && !collider->isStaticWalkable(center.x / Globals::MAP_TILE_SIZE, center.y / Globals::MAP_TILE_SIZE))
+        {
+            wallHits++;
+            Remove(index);
+            continue;
+        }
+        ++index;
+    }
+}
+
+void EnemyProjectileSystem::Draw(const int index) const
+{
+    auto* graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    // Filled circle with an outline
+    const pdcpp::Point<int> position = positions[index];
+    const int size = sizes[index];
+    graphics->drawEllipse(position.x, position.y, size, size, 1, 0, 0, kColorWhite);
+    const int fillSize = size - 2;
+    if (fillSize > 0)
+    {
+        graphics->fillEllipse(position.x + 1, position.y + 1, fillSize, fillSize, 0, 0, kColorBlack);
+    }
+}
+
+void EnemyProjectileSystem::Remove(const int index)
+{
+    const int last = Size() - 1;
+    if (index != last)
+    {
+        positions[index] = positions[last];
+        velocities[index] = velocities[last];
+        sizes[index] = sizes[last];
+        damages[index] = damages[last];
+        bornTimes[index] = bornTimes[last];
+    }
+    positions.pop_back();
+    velocities.pop_back();
+    sizes.pop_back();
+    damages.pop_back();
+    bornTimes.pop_back();
+}
+
+void EnemyProjectileSystem::Clear()
+{
+    positions.clear();
+    velocities.clear();
+    sizes.clear();
+    damages.clear();
+    bornTimes.clear();
+}
+
+HitShape EnemyProjectileSystem::GetHitShape(const int index) const
+{
+    const float projectileRadius = static_cast<float>(sizes[index]) / 2.f;
+    const float playerRadius = static_cast<float>(Globals::PLAYER_SIZE) / 2.f;
+    return HitShape::Circle(GetCenter(index), projectileRadius + playerRadius);
+}
+
+pdcpp::Point<int> EnemyProjectileSystem::GetCenter(const int index) const
+{
+    const int halfSize = sizes[index] / 2;
+    return {positions[index].x + halfSize, positions[index].y + halfSize};
+}
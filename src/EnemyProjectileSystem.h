@@ -0,0 +1,55 @@
+#ifndef CARDOBLAST_ENEMYPROJECTILESYSTEM_H
+#define CARDOBLAST_ENEMYPROJECTILESYSTEM_H
+
+#include "HitShape.h"
+#include "pdcpp/graphics/Point.h"
+#include <vector>
+
+class MapCollision;
+
+/**
+ * @brief Enemy projectiles of an area, as parallel arrays.
+ *
+ * The arrays are reserved for Globals::ENEMY_PROJECTILE_CAPACITY projectiles and never grow,
+ * a shot fired over capacity is dropped. Each tick integrates the positions in one pass and
+ * kills the projectiles that left walkable terrain (one static tile lookup) or outlived
+ * Globals::MONSTER_PROJECTILE_LIFETIME. Hits on the player are resolved by the CollisionPhase.
+ *
+ * Removing a projectile moves the last one into its index.
+ */
+class EnemyProjectileSystem
+{
+public:
+    EnemyProjectileSystem();
+
+    // Returns false if the system is full
+    bool Fire(pdcpp::Point<int> position, float angle, float speed, unsigned int size, float damage, unsigned int currentTime);
+    void Update(const MapCollision* collider, unsigned int currentTime);
+    void Draw(int index) const;
+    void Remove(int index);
+    void Clear();
+
+    // Circle around the projectile's center, grown by the player's radius
+    [[nodiscard]] HitShape GetHitShape(int index) const;
+    [[nodiscard]] float GetDamage(int index) const { return damages[index]; }
+    // Top left corner, pixels
+    [[nodiscard]] pdcpp::Point<int> GetPosition(int index) const { return positions[index]; }
+    // Diameter, pixels
+    [[nodiscard]] int GetSize(int index) const { return sizes[index]; }
+    [[nodiscard]] int Size() const { return static_cast<int>(positions.size()); }
+    [[nodiscard]] int GetDroppedCount() const { return dropped; }
+    [[nodiscard]] int GetWallHits() const { return wallHits; }
+
+private:
+    [[nodiscard]] pdcpp::Point<int> GetCenter(int index) const;
+
+    std::vector<pdcpp::Point<int>> positions; // top left corner, pixels
+    std::vector<pdcpp::Point<int>> velocities; // pixels per tick
+    std::vector<unsigned char> sizes; // diameter, pixels
+    std::vector<float> damages;
+    std::vector<unsigned int> bornTimes; // milliseconds
+    int dropped = 0;
+    int wallHits = 0;
+};
+
+#endif //CARDOBLAST_ENEMYPROJECTILESYSTEM_H
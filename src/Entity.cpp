@@ -5,8 +5,10 @@
 #include "Entity.h"
 
 #include <cmath>
+#include "DrawList.h"
 #include "Globals.h"
 #include "Log.h"
+#include "SpriteAtlas.h"
 #include "pdcpp/core/GlobalPlaydateAPI.h"
 
 std::unordered_map<std::string, LCDBitmap*> Entity::bitmapCache;
@@ -55,8 +57,19 @@ void Entity::LoadBitmap(const std::string& path)
     LoadBitmap();
 }
 
+void Entity::SetAtlasSprite(const SpriteAtlas* _atlas, const int frame)
+{
+    atlas = _atlas;
+    atlasFrame = frame;
+}
+
 void Entity::DrawBitmap() const
 {
+    if (atlas)
+    {
+        atlas->DrawFrame(atlasFrame, position.x, position.y, kBitmapUnflipped);
+        return;
+    }
     if (bitmap == nullptr)
     {
         Log::Error("Entity %d has no bitmap loaded", id);
@@ -88,57 +101,75 @@ bool Entity::CalculateFlashing()
     return true; // If not flashing, always return true (visible)
 }
 
-void Entity::Draw()
+void Entity::SubmitDraw(DrawList& drawList)
 {
     if (hp>0)
     {
         if (CalculateFlashing())
         {
-            DrawBitmap();
+            drawList.SubmitEntity(DrawList::Layer::Sprites, DrawList::Type::EntityBody, GetDrawBaseline(), this);
         }
-        DrawHealthBar(Globals::HEALTH_BAR_OFFSET_X, Globals::HEALTH_BAR_OFFSET_Y);
+        drawList.SubmitEntity(DrawList::Layer::Overlay, DrawList::Type::EntityOverlay, GetDrawBaseline(), this);
 
         lastDamage = (isFlashing ? lastDamage : 0.f);
-
-        if (lastDamage != 0)
-        {
-            getInGameFont().drawText(std::to_string(static_cast<int>(lastDamage*10)), position.x, position.y - flashTimer - 10);
-        }
         sparks.update();
-        sparks.draw();
+        drawList.SubmitEntity(DrawList::Layer::Effects, DrawList::Type::EntityEffects, GetDrawBaseline(), this);
     }
     else if (deathToEraseCountdown > 0)
     {
         deathToEraseCountdown--;
+        drawList.SubmitEntity(DrawList::Layer::Effects, DrawList::Type::EntityDeath, GetDrawBaseline(), this);
+    }
+}
 
-        // Rotating cross effect - expands and rotates from center
-        int length = (Globals::DEATH_COUNTDOWN_MAX - deathToEraseCountdown) * 2;
-        auto center = GetCenteredPosition();
+void Entity::DrawBody()
+{
+    DrawBitmap();
+}
 
-        // Calculate rotation angle based on countdown (rotates as it expands)
-        float angle = (Globals::DEATH_COUNTDOWN_MAX - deathToEraseCountdown) * 10.0f; // degrees per frame
-        float angleRad = angle * 3.14159f / 180.0f;
+void Entity::DrawEffects() const
+{
+    if (lastDamage != 0)
+    {
+        getInGameFont().drawText(std::to_string(static_cast<int>(lastDamage*10)), position.x, position.y - flashTimer - 10);
+    }
+    sparks.draw();
+}
 
-        // Draw 8 lines rotated at 45 degree intervals (like a spinning cross)
-        for (int i = 0; i < 8; i++)
-        {
-            float currentAngle = angleRad + (i * 3.14159f / 4.0f); // 90 degrees apart
-
-            // Calculate line endpoints using rotation
-            int x1 = center.x + static_cast<int>(length * cos(currentAngle));
-            int y1 = center.y + static_cast<int>(length * sin(currentAngle));
-            int x2 = center.x - static_cast<int>(length * cos(currentAngle));
-            int y2 = center.y - static_cast<int>(length * sin(currentAngle));
-
-            pdcpp::Graphics::drawLine(
-                {x1, y1},
-                {x2, y2},
-                2, kColorWhite
-            );
-        }
+void Entity::DrawDeath() const
+{
+    // Rotating cross effect - expands and rotates from center
+    int length = (Globals::DEATH_COUNTDOWN_MAX - deathToEraseCountdown) * 2;
+    auto center = GetCenteredPosition();
+
+    // Calculate rotation angle based on countdown (rotates as it expands)
+    float angle = (Globals::DEATH_COUNTDOWN_MAX - deathToEraseCountdown) * 10.0f; // degrees per frame
+    float angleRad = angle * 3.14159f / 180.0f;
+
+    // Draw 8 lines rotated at 45 degree intervals (like a spinning cross)
+    for (int i = 0; i < 8; i++)
+    {
+        float currentAngle = angleRad + (i * 3.14159f / 4.0f); // 90 degrees apart
+
+        // Calculate line endpoints using rotation
+        int x1 = center.x + static_cast<int>(length * cos(currentAngle));
+        int y1 = center.y + static_cast<int>(length * sin(currentAngle));
+        int x2 = center.x - static_cast<int>(length * cos(currentAngle));
+        int y2 = center.y - static_cast<int>(length * sin(currentAngle));
+
+        pdcpp::Graphics::drawLine(
+            {x1, y1},
+            {x2, y2},
+            2, kColorWhite
+        );
     }
 }
 
+void Entity::DrawOverlay() const
+{
+    DrawHealthBar(Globals::HEALTH_BAR_OFFSET_X, Globals::HEALTH_BAR_OFFSET_Y);
+}
+
 void Entity::DrawHealthBar(pdcpp::Point<int> offset) const
 {
     DrawHealthBar(offset.x, offset.y);
@@ -13,7 +13,9 @@
 #include "pdcpp/graphics/Point.h"
 #include "pdcpp/graphics/Font.h"
 
+class DrawList;
 class EntityManager;
+class SpriteAtlas;
 
 
 class Entity
@@ -26,6 +28,7 @@ public:
     explicit Entity(unsigned int _id);
     Entity(const Entity& other) = default;
     Entity(Entity&& other) noexcept = default;
+    Entity& operator=(const Entity& other) = default;
     virtual ~Entity() = default;
 
     [[nodiscard]] unsigned int GetId() const {return id;}
@@ -52,12 +55,22 @@ public:
     void Damage(float damage);
     void Heal(float heal);
 
-    virtual void Draw();
+    // Advance the flashing, sparks and death animations by a frame, and submit what's left to draw
+    virtual void SubmitDraw(DrawList& drawList);
+    // Parts run by the DrawList
+    virtual void DrawBody();
+    void DrawEffects() const; // damage number and sparks
+    void DrawDeath() const;
+    virtual void DrawOverlay() const; // health bar
+    // y of the feet, the sort key of the sprite
+    [[nodiscard]] virtual int GetDrawBaseline() const { return position.y + Globals::MAP_TILE_SIZE; }
     void DrawHealthBar(pdcpp::Point<int>) const;
     void DrawHealthBar(int, int) const;
 
     void LoadBitmap();
     void LoadBitmap(const std::string& path);
+    // Draw the sprite from a frame of a shared atlas instead of its own bitmap
+    void SetAtlasSprite(const SpriteAtlas* atlas, int frame);
     void DrawBitmap() const;
     void DrawBitmap(int x, int y);
     bool CalculateFlashing();
@@ -78,6 +91,8 @@ private:
     float maxHP{};
     std::string description;
     LCDBitmap* bitmap{};
+    const SpriteAtlas* atlas{};
+    int atlasFrame = -1;
     bool isBitmapVisible = true;
     int flashTimer = 0;
     bool isFlashing = false;
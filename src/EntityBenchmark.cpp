@@ -0,0 +1,71 @@
+#include "EntityBenchmark.h"
+#include "Area.h"
+#include "EntityManager.h"
+#include "Globals.h"
+#include "Log.h"
+#include "Monster.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    template <typename T>
+    void RunLookups(EntityManager& entityManager, const char* name)
+    {
+        auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+        const EntityRegistry<T>& registry = entityManager.GetRegistry<T>();
+
+        std::vector<unsigned int> ids;
+        std::vector<typename EntityRegistry<T>::Handle> handles;
+        std::map<unsigned int, std::shared_ptr<void>> baseline; // the old storage
+        for (const auto& entity : registry.GetAll())
+        {
+            ids.push_back(entity->GetId());
+            handles.push_back(registry.Find(entity->GetId()));
+            baseline[entity->GetId()] = entity;
+        }
+        if (ids.empty()) return;
+
+        unsigned int found = 0;
+        float startTime = system->getElapsedTime();
+        for (int pass = 0; pass < Globals::ENTITY_BENCHMARK_PASSES; ++pass)
+        {
+            for (const unsigned int id : ids)
+            {
+                if (std::static_pointer_cast<T>(baseline.find(id)->second)) found++;
+            }
+        }
+        const int mapUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+
+        startTime = system->getElapsedTime();
+        for (int pass = 0; pass < Globals::ENTITY_BENCHMARK_PASSES; ++pass)
+        {
+            for (const unsigned int id : ids)
+            {
+                if (entityManager.Get<T>(id)) found++;
+            }
+        }
+        const int idUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+
+        startTime = system->getElapsedTime();
+        for (int pass = 0; pass < Globals::ENTITY_BENCHMARK_PASSES; ++pass)
+        {
+            for (const auto handle : handles)
+            {
+                if (registry.Get(handle)) found++;
+            }
+        }
+        const int handleUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+
+        Log::Info("Entity benchmark %s: %u lookups, map %d us, registry %d us, handles %d us",
+                  name, found, mapUs, idUs, handleUs);
+    }
+}
+
+void EntityBenchmark::Run(EntityManager& entityManager)
+{
+    RunLookups<Monster>(entityManager, "monsters");
+    RunLookups<Area>(entityManager, "areas");
+}
@@ -0,0 +1,19 @@
+#ifndef CARDOBLAST_ENTITYBENCHMARK_H
+#define CARDOBLAST_ENTITYBENCHMARK_H
+
+class EntityManager;
+
+/**
+ * @brief Development benchmark of entity lookups once the JSON files are loaded.
+ *
+ * Looks up every loaded monster and area Globals::ENTITY_BENCHMARK_PASSES times by id through
+ * the typed registries, through their handles, and through a std::map of shared_ptr<void> like
+ * the one the EntityManager used before, and logs the time of each. Load times are logged by
+ * EntityManager::LoadJSON. Only runs when Globals::RUN_ENTITY_BENCHMARK is enabled.
+ */
+namespace EntityBenchmark
+{
+    void Run(EntityManager& entityManager);
+}
+
+#endif //CARDOBLAST_ENTITYBENCHMARK_H
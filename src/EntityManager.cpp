@@ -10,25 +10,19 @@
 #include "Log.h"
 #include "Utils.h"
 #include "pdcpp/core/File.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
 
 EntityManager::EntityManager()
 {
     // No singleton initialization needed
 }
-EntityManager::~EntityManager()
-{
-    for (std::pair<const unsigned, std::shared_ptr<void>>& entity : data)
-    {
-        entity.second = nullptr;
-    }
-}
-std::shared_ptr<void> EntityManager::GetEntity(unsigned int id)
+EntityManager::~EntityManager() = default;
+
+std::shared_ptr<Item> EntityManager::GetItem(const unsigned int id)
 {
-    auto it = data.find(id);
-    if(it!=data.end())
-    {
-        return it->second;
-    }
+    if (auto item = items.Get(id)) return item;
+    if (auto weapon = weapons.Get(id)) return weapon;
+    if (auto armor = armors.Get(id)) return armor;
     return nullptr;
 }
 
@@ -47,7 +41,11 @@ void EntityManager::LoadJSON(const char* fileName, int limitOfTokens)
     fileHandle->read(charBuffer.get(), fileHandle->getDetails().size);
     auto parser = std::make_unique<jsmn_parser>();
     jsmn_init(parser.get());
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float startTime = system->getElapsedTime();
     DecodeJson<T>(parser.get(), charBuffer.get(), fileHandle->getDetails().size, limitOfTokens);
+    const int elapsedUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+    Log::Info("Loaded %s: %d entities, %d us", fileName, GetRegistry<T>().Size(), elapsedUs);
     // Automatic cleanup via unique_ptr destructors
 }
 template <typename T>
@@ -58,10 +56,12 @@ void EntityManager::DecodeJson(jsmn_parser *parser, char *charBuffer, const size
     Log::Info("Just initialized JSMN with %d tokens", calculatedTokens);
     T dummy{};
     std::shared_ptr<void> decodedJson = dummy.DecodeJson(charBuffer, t.get(), calculatedTokens, this);
-    auto items = static_cast<std::vector<T>*>(decodedJson.get());
-    for (T item : *items)
+    auto decoded = static_cast<std::vector<T>*>(decodedJson.get());
+    EntityRegistry<T>& registry = GetRegistry<T>();
+    registry.Reserve(registry.Size() + static_cast<int>(decoded->size()));
+    for (T& item : *decoded)
     {
-        data[item.GetId()] = std::make_shared<T>(item);
+        registry.Add(std::move(item)); // the decoded vector is dropped right after
     }
     // Automatic cleanup via unique_ptr destructor
 }
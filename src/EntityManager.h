@@ -1,18 +1,31 @@
 #ifndef ENTITY_MANAGER_H
 #define ENTITY_MANAGER_H
 
-#include <map>
 #include <memory>
 #include <utility>
 #include <pd_api.h>
 #include "jsmn.h"
+#include "Armor.h"
+#include "Door.h"
+#include "EntityRegistry.h"
+#include "Item.h"
+#include "Monster.h"
 #include "UI.h"
 #include "Player.h"
+#include "Weapon.h"
+
+class Area;
 
 class EntityManager
 {
 private:
-    std::map<unsigned int, std::shared_ptr<void>> data;
+    // One dense registry per entity type loaded from JSON
+    EntityRegistry<Item> items;
+    EntityRegistry<Door> doors;
+    EntityRegistry<Weapon> weapons;
+    EntityRegistry<Armor> armors;
+    EntityRegistry<Monster> monsters;
+    EntityRegistry<Area> areas;
     std::shared_ptr<Player> player;
 
 public:
@@ -30,9 +43,22 @@ public:
     template <typename T>
     void DecodeJson(jsmn_parser *parser, char *charBuffer, size_t len, int tokenLimit);
 
-    std::shared_ptr<void> GetEntity(unsigned int id);
+    // Only the types above have a registry, anything else doesn't compile
+    template <typename T>
+    [[nodiscard]] EntityRegistry<T>& GetRegistry();
+    template <typename T>
+    [[nodiscard]] std::shared_ptr<T> Get(unsigned int id) { return GetRegistry<T>().Get(id); }
+    // Items, weapons and armors share the item ids, as inventory entries
+    [[nodiscard]] std::shared_ptr<Item> GetItem(unsigned int id);
     [[nodiscard]] std::shared_ptr<Player> GetPlayer() const {return player;};
     void SetPlayer(const std::shared_ptr<Player>& Player){player = Player;}
 };
 
+template <> inline EntityRegistry<Item>& EntityManager::GetRegistry<Item>() { return items; }
+template <> inline EntityRegistry<Door>& EntityManager::GetRegistry<Door>() { return doors; }
+template <> inline EntityRegistry<Weapon>& EntityManager::GetRegistry<Weapon>() { return weapons; }
+template <> inline EntityRegistry<Armor>& EntityManager::GetRegistry<Armor>() { return armors; }
+template <> inline EntityRegistry<Monster>& EntityManager::GetRegistry<Monster>() { return monsters; }
+template <> inline EntityRegistry<Area>& EntityManager::GetRegistry<Area>() { return areas; }
+
 #endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef CARDOBLAST_ENTITYREGISTRY_H
+#define CARDOBLAST_ENTITYREGISTRY_H
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Dense store of the entities of one type loaded from JSON, looked up by id.
+ *
+ * Entities are appended to a flat array and never move, so the index in it is a stable handle.
+ * A second array of (id, index) pairs is kept sorted by id, and an id lookup is a binary search
+ * over it. Handles are typed by the registry they come from, so a Door handle can't be used
+ * to read a Monster.
+ */
+template <typename T>
+class EntityRegistry
+{
+public:
+    struct Handle
+    {
+        int index = -1;
+        [[nodiscard]] bool IsValid() const { return index >= 0; }
+    };
+
+    // Takes the decoded entity by move. An entity with the same id replaces the previous one.
+    Handle Add(T&& entity)
+    {
+        const unsigned int id = entity.GetId();
+        auto it = std::lower_bound(ids.begin(), ids.end(), id, [](const IdEntry& entry, const unsigned int value) { return entry.id < value; });
+        if (it != ids.end() && it->id == id)
+        {
+            entities[it->index] = std::make_shared<T>(std::move(entity));
+            return {it->index};
+        }
+
+        const int index = static_cast<int>(entities.size());
+        entities.push_back(std::make_shared<T>(std::move(entity)));
+        ids.insert(it, {id, index});
+        return {index};
+    }
+
+    [[nodiscard]] Handle Find(const unsigned int id) const
+    {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id, [](const IdEntry& entry, const unsigned int value) { return entry.id < value; });
+        if (it == ids.end() || it->id != id) return {};
+        return {it->index};
+    }
+
+    [[nodiscard]] const std::shared_ptr<T>& Get(const Handle handle) const
+    {
+        static const std::shared_ptr<T> none;
+        if (handle.index < 0 || handle.index >= static_cast<int>(entities.size())) return none;
+        return entities[handle.index];
+    }
+    // nullptr if there's no entity with that id
+    [[nodiscard]] const std::shared_ptr<T>& Get(const unsigned int id) const { return Get(Find(id)); }
+
+    [[nodiscard]] int Size() const { return static_cast<int>(entities.size()); }
+    [[nodiscard]] const std::vector<std::shared_ptr<T>>& GetAll() const { return entities; }
+    void Reserve(const int count)
+    {
+        entities.reserve(count);
+        ids.reserve(count);
+    }
+
+private:
+    struct IdEntry
+    {
+        unsigned int id;
+        int index;
+    };
+
+    std::vector<std::shared_ptr<T>> entities; // in load order, indexed by Handle
+    std::vector<IdEntry> ids; // sorted by id
+};
+
+#endif //CARDOBLAST_ENTITYREGISTRY_H
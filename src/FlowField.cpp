@@ -0,0 +1,106 @@
+#include "FlowField.h"
+#include "MapCollision.h"
+#include "PathCosts.h"
+#include <algorithm>
+#include <functional>
+
+bool FlowField::Update(const MapCollision* collider, const pdcpp::Point<int> newTarget)
+{
+    if (collider == nullptr)
+    {
+        valid = false;
+        return false;
+    }
+
+    if (valid && newTarget == target && staticVersion == collider->getStaticVersion())
+    {
+        return false;
+    }
+
+    target = newTarget;
+    staticVersion = collider->getStaticVersion();
+    Rebuild(collider);
+    return true;
+}
+
+void FlowField::Rebuild(const MapCollision* collider)
+{
+    width = collider->map_size.x;
+    height = collider->map_size.y;
+    distances.assign(static_cast<size_t>(width) * height, UNREACHABLE);
+    open.clear();
+    rebuildCount++;
+    valid = true;
+
+    if (!IsInside(target.x, target.y))
+    {
+        return;
+    }
+
+    // Plain Dijkstra from the target. Every tile ends up holding its cost to reach the target.
+    const int targetIndex = target.y * width + target.x;
+    distances[targetIndex] = 0;
+    open.push_back({0, targetIndex});
+
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        const OpenEntry current = open.back();
+        open.pop_back();
+
+        if (current.cost > distances[current.index]) continue; // stale entry
+
+        const int cx = current.index % width;
+        const int cy = current.index / width;
+        for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+        {
+            const int nx = cx + PathCosts::NEIGHBOUR_DX[i];
+            const int ny = cy + PathCosts::NEIGHBOUR_DY[i];
+            if (!IsInside(nx, ny) || !collider->isStaticWalkable(nx, ny)) continue;
+
+            const bool diagonal = PathCosts::NEIGHBOUR_DX[i] != 0 && PathCosts::NEIGHBOUR_DY[i] != 0;
+            // Don't cut corners, monsters move in a straight line between tile centers
+            if (diagonal && (!collider->isStaticWalkable(cx, ny) || !collider->isStaticWalkable(nx, cy))) continue;
+
+            const unsigned int cost = current.cost + (diagonal ? PathCosts::DIAGONAL_COST : PathCosts::STRAIGHT_COST);
+            const int index = ny * width + nx;
+            if (cost < distances[index])
+            {
+                distances[index] = cost;
+                open.push_back({cost, index});
+                std::push_heap(open.begin(), open.end(), std::greater<>());
+            }
+        }
+    }
+}
+
+unsigned int FlowField::GetDistance(const int x, const int y) const
+{
+    if (!valid || !IsInside(x, y)) return UNREACHABLE;
+    return distances[y * width + x];
+}
+
+bool FlowField::GetNextStep(const pdcpp::Point<int> from, pdcpp::Point<int>& next, MapCollision* collider) const
+{
+    const unsigned int currentDistance = GetDistance(from.x, from.y);
+    if (currentDistance == UNREACHABLE || currentDistance == 0) return false;
+
+    unsigned int bestDistance = currentDistance;
+    bool found = false;
+    for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+    {
+        const int nx = from.x + PathCosts::NEIGHBOUR_DX[i];
+        const int ny = from.y + PathCosts::NEIGHBOUR_DY[i];
+        const unsigned int distance = GetDistance(nx, ny);
+        if (distance >= bestDistance) continue;
+
+        if (PathCosts::NEIGHBOUR_DX[i] != 0 && PathCosts::NEIGHBOUR_DY[i] != 0
+            && (GetDistance(from.x, ny) == UNREACHABLE || GetDistance(nx, from.y) == UNREACHABLE)) continue;
+        if (collider != nullptr && collider->IsTileBlockedByChar(nx, ny)) continue;
+
+        bestDistance = distance;
+        next = {nx, ny};
+        found = true;
+    }
+    return found;
+}
@@ -0,0 +1,66 @@
+#ifndef CARDOBLAST_FLOWFIELD_H
+#define CARDOBLAST_FLOWFIELD_H
+
+#include "pdcpp/graphics/Point.h"
+#include <vector>
+
+class MapCollision;
+
+/**
+ * @brief Distance field towards a single target tile, shared by every monster chasing it.
+ *
+ * Instead of each monster running its own A* search, one Dijkstra expansion is done from
+ * the target over the static collision layer. Monsters then just step to the neighbour
+ * with the lowest distance. The field is only rebuilt when the target changes tile or
+ * the collision map terrain changes, and all buffers are reused between rebuilds.
+ */
+class FlowField
+{
+public:
+    static constexpr unsigned int UNREACHABLE = 0xFFFFFFFF;
+
+    FlowField() = default;
+
+    /**
+     * @brief Rebuild the field if the target tile or the collider terrain changed.
+     * @return true if the field was rebuilt
+     */
+    bool Update(const MapCollision* collider, pdcpp::Point<int> target);
+    void Invalidate() { valid = false; }
+
+    /**
+     * @brief Pick the neighbour of `from` that is closest to the target.
+     *
+     * Tiles currently occupied by another monster are skipped, so crowds spread around
+     * obstacles instead of queueing on the same tile.
+     * @return false if there's no better tile to move to
+     */
+    bool GetNextStep(pdcpp::Point<int> from, pdcpp::Point<int>& next, MapCollision* collider) const;
+
+    [[nodiscard]] unsigned int GetDistance(int x, int y) const;
+    [[nodiscard]] bool IsValid() const { return valid; }
+    [[nodiscard]] pdcpp::Point<int> GetTarget() const { return target; }
+    [[nodiscard]] unsigned int GetRebuildCount() const { return rebuildCount; }
+
+private:
+    struct OpenEntry
+    {
+        unsigned int cost;
+        int index;
+        bool operator>(const OpenEntry& other) const { return cost > other.cost; }
+    };
+
+    void Rebuild(const MapCollision* collider);
+    [[nodiscard]] bool IsInside(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+
+    std::vector<unsigned int> distances; // row-major, y * width + x
+    std::vector<OpenEntry> open; // binary heap reused between rebuilds
+    pdcpp::Point<int> target = {-1, -1};
+    int width = 0;
+    int height = 0;
+    unsigned int staticVersion = 0;
+    unsigned int rebuildCount = 0;
+    bool valid = false;
+};
+
+#endif //CARDOBLAST_FLOWFIELD_H
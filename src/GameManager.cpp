@@ -1,6 +1,10 @@
 #include "GameManager.h"
 #include "Globals.h"
+#include "DStarBenchmark.h"
+#include "EntityBenchmark.h"
 #include "Log.h"
+#include "MonsterBenchmark.h"
+#include "PathfindingBenchmark.h"
 #include "pdcpp/core/File.h"
 
 GameManager::GameManager(PlaydateAPI* api)
@@ -14,11 +18,25 @@ GameManager::GameManager(PlaydateAPI* api)
     ui->SetOnGameOverSelected([this]() { CleanGame(); });
     ui->SetOnSaveGameSelected([this]() { SaveGame(); });
     ui->SetMaxScorePointer(&maxScore);
+
+    if constexpr (Globals::RUN_PATHFINDING_BENCHMARK)
+    {
+        PathfindingBenchmark::Run();
+    }
+    if constexpr (Globals::RUN_MONSTER_BENCHMARK)
+    {
+        MonsterBenchmark::Run();
+    }
+    if constexpr (Globals::RUN_DSTAR_BENCHMARK)
+    {
+        DStarBenchmark::Run();
+    }
 }
 void GameManager::Update()
 {
-    pd->graphics->clear(kColorBlack);
-
+    bool worldFrame = false; // the game was ticked and its objects submitted this frame
+    pdcpp::Point<int> screenOffset = {0,0}; // graphics draw offset of the world
+    pdcpp::Point<int> cameraCenter = {0,0}; // world pixel at the center of the screen
 
     if (!isGameRunning)
     {
@@ -79,6 +97,10 @@ void GameManager::Update()
                     break;
                 case 5:
                     entityManager->LoadJSON<Area>(jsonPaths[frameCount], tokenCount[frameCount]);
+                    if constexpr (Globals::RUN_ENTITY_BENCHMARK)
+                    {
+                        EntityBenchmark::Run(*entityManager);
+                    }
                     break;
                 default:
                     progress = 1.f;
@@ -144,6 +166,7 @@ void GameManager::Update()
             }
         }
         pd->graphics->setDrawOffset(drawOffset.x, drawOffset.y);
+        screenOffset = drawOffset;
         drawOffset.x = -drawOffset.x+screenCenterWidth;
         drawOffset.y = -drawOffset.y+screenCenterHeight;
 
@@ -153,13 +176,49 @@ void GameManager::Update()
             drawOffset.x += random.nextFloatInRange(-3.f, 3.f);
             drawOffset.y += random.nextFloatInRange(-3.f, 3.f);
         }
-        activeArea->Render(drawOffset.x, drawOffset.y, Globals::PLAYER_FOV_X, Globals::PLAYER_FOV_Y);
-        player->Draw();
-        player->DrawMagic(); // Draw magic projectiles on top of the map
+        cameraCenter = drawOffset;
+        // The world objects are culled against the field of view once, and drawn sorted on top of the map
+        drawList.Begin({drawOffset.x - Globals::PLAYER_FOV_X, drawOffset.y - Globals::PLAYER_FOV_Y, 2 * Globals::PLAYER_FOV_X, 2 * Globals::PLAYER_FOV_Y});
+        activeArea->SubmitDraw(drawList);
+        player->SubmitDraw(drawList);
         ui->SetOffset(drawOffset);
+        worldFrame = true;
     }
 
     ui->Update();
+    // The UI may have ended the game while handling its inputs
+    if (worldFrame && isGameRunning && activeArea)
+    {
+        // While the camera holds still only what moved is redrawn: the old and new place of every world
+        // object, and the HUD elements that changed. A scroll changes every pixel, so it redraws everything.
+        if (!Globals::PARTIAL_SCREEN_UPDATES || !worldOnScreen || screenOffset != drawnScreenOffset ||
+            activeArea->HasMapChanged() || !drawList.MarkDirtyRegions(screenRegions, screenOffset))
+        {
+            screenRegions.MarkAll();
+        }
+        ui->CollectDirtyRegions(screenRegions);
+        if (screenRegions.Begin(kColorBlack, screenOffset))
+        {
+            activeArea->RenderMap(cameraCenter.x, cameraCenter.y, Globals::PLAYER_FOV_X, Globals::PLAYER_FOV_Y);
+            drawList.Execute();
+            ui->Draw();
+            screenRegions.End();
+        }
+        worldOnScreen = true;
+        drawnScreenOffset = screenOffset;
+    }
+    else
+    {
+        // Menus and loading only redraw what changed, the rest of the frame buffer is kept
+        if (!Globals::PARTIAL_SCREEN_UPDATES) screenRegions.MarkAll();
+        ui->CollectDirtyRegions(screenRegions);
+        if (screenRegions.Begin(kColorBlack))
+        {
+            ui->Draw();
+            screenRegions.End();
+        }
+        worldOnScreen = false;
+    }
     pd->system->drawFPS(0,0);
 }
 
@@ -172,7 +231,7 @@ GameManager::~GameManager()
 
 void GameManager::LoadNewGame()
 {
-    activeArea = std::static_pointer_cast<Area>(entityManager->GetEntity(9002));
+    activeArea = entityManager->Get<Area>(9002);
     activeArea->SetEntityManager(entityManager.get());
 
     // Show loading screen for procedural generation
@@ -198,7 +257,7 @@ void GameManager::LoadSavedGame()
     }
 
     // Get the area from entity manager based on saved area ID
-    activeArea = std::static_pointer_cast<Area>(entityManager->GetEntity(areaId));
+    activeArea = entityManager->Get<Area>(areaId);
     if (!activeArea)
     {
         Log::Error("GameManager::LoadSavedGame - Area with ID %u not found in entity manager", areaId);
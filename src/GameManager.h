@@ -25,6 +25,8 @@
 #include "Player.h"
 #include "UI.h"
 #include "SaveGame.h"
+#include "DirtyRegions.h"
+#include "DrawList.h"
 #include "pdcpp/graphics/Point.h"
 
 /**
@@ -55,7 +57,7 @@ public:
      * - Update player and area (if game is running)
      * - Continue map generation (if loading)
      * - Update camera position
-     * - Render all game objects
+     * - Render all game objects, or only the changed regions of menus and loading screens
      * - Handle level-up popup
      * - Check for game over
      */
@@ -107,6 +109,16 @@ public:
      */
     [[nodiscard]] int GetMaxScore() const { return maxScore; }
 
+    /**
+     * @brief Counters of the last screen update (dirty regions, redrawn rows, time).
+     */
+    [[nodiscard]] const ScreenUpdateStats& GetScreenUpdateStats() const { return screenRegions.GetStats(); }
+
+    /**
+     * @brief Counters of the last world draw list (commands, culled objects, batches, time).
+     */
+    [[nodiscard]] const DrawListStats& GetDrawListStats() const { return drawList.GetStats(); }
+
 private:
     PlaydateAPI* pd;                                   ///< Playdate SDK API pointer
     std::unique_ptr<EntityManager> entityManager;      ///< Entity registry and loader
@@ -114,6 +126,10 @@ private:
     std::shared_ptr<UI> ui;                           ///< User interface system
     std::shared_ptr<Area> activeArea;                 ///< Current level/map
     pdcpp::Point<int> currentCameraOffset = {0,0};     ///< Camera position for smooth follow
+    DirtyRegions screenRegions;                        ///< Changed regions of the screen this frame
+    bool worldOnScreen = false;                        ///< The last frame drawn was the game, not a menu
+    pdcpp::Point<int> drawnScreenOffset = {0,0};       ///< Draw offset the game was last drawn with
+    DrawList drawList;                                 ///< World objects drawn this frame, sorted
     bool isGameRunning = false;                        ///< True when gameplay is active
     int maxScore = 0;                                  ///< Highest survival time (seconds)
 
@@ -0,0 +1,20 @@
+#ifndef CARDOBLAST_GENERATIONALHANDLE_H
+#define CARDOBLAST_GENERATIONALHANDLE_H
+
+/**
+ * @brief Non-owning reference to an entry of a store: an index plus the generation it had when issued.
+ *
+ * The store bumps the generation of an index when its entry is removed, so a handle to a dead
+ * entity stops resolving even after the index is reused. Checking it is an array read and a
+ * compare, without the reference counting of a weak_ptr.
+ */
+struct GenerationalHandle
+{
+    int index = -1;
+    unsigned int generation = 0;
+
+    [[nodiscard]] bool IsNull() const { return index < 0; }
+    bool operator==(const GenerationalHandle& other) const = default;
+};
+
+#endif //CARDOBLAST_GENERATIONALHANDLE_H
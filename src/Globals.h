@@ -31,9 +31,26 @@ namespace Globals
     // ========================================================================
     // PATHFINDING CONSTANTS
     // ========================================================================
-    constexpr int MAX_PATH_FIND_FAILURE_COUNT = 2;      ///< Max pathfinding failures before reset
-    constexpr int MULT_FOR_RESET_PATH_FIND_FAILURE = 15; ///< Count to reset pathfinding failure
-    constexpr int PATH_FINDING_COOLDOWN = 50;           ///< Cooldown between path recalculations (ticks)
+    constexpr int MAX_PATH_FIND_FAILURE_COUNT = 2;      ///< Failed searches towards one target before a monster stops asking
+    constexpr int PATH_FINDING_COOLDOWN = 50;           ///< Cooldown between path recalculations (ticks), maps too big for D* Lite
+    // A planner holds ~19 bytes per tile (g, rhs, queued key, three flags) plus its queue: ~30 KB on a
+    // 40x40 map and ~78 KB at this cap, for every kiting monster alive (MONSTER_MAX_LIVING_COUNT at most).
+    // The MonsterStore frees it with the living monster.
+    constexpr int DSTAR_MAX_MAP_TILES = 64 * 64;        ///< Biggest map where monsters keep their own D* Lite planner
+    constexpr int DSTAR_MAX_EXPANSIONS_PER_UPDATE = 400; ///< D* Lite work per update, the rest carries over
+    constexpr int DSTAR_GOAL_DRIFT = 3;                 ///< Tiles a far away target can move before D* Lite follows it
+    constexpr int DSTAR_SMOOTHING_LOOKAHEAD = 8;        ///< Planner steps MONSTER_PATH_SMOOTHING looks at to pick the next node
+    constexpr int PATHFINDING_FRAME_BUDGET_US = 3000;   ///< Time the path scheduler may spend per frame (microseconds)
+    constexpr int PATHFINDING_SLICE_EXPANSIONS = 64;    ///< Tiles a scheduled search expands before checking the budget
+    // Priority is the tile distance to the player plus this penalty off screen, minus one per frame waited.
+    // Worst case, an off screen request at MONSTER_AWARENESS_RADIUS overtakes a fresh request next to the
+    // player after 10 + 50 = 60 frames (3 s at 20 FPS), and one at the same distance after 10 frames.
+    constexpr int PATHFINDING_OFFSCREEN_PRIORITY = 10;  ///< Priority penalty for path requests of off screen monsters (frames of waiting)
+    constexpr bool MONSTER_PATH_SMOOTHING = true;       ///< Collapse computed paths to the waypoints where they turn
+    constexpr int HPA_CLUSTER_SIZE = 16;                ///< Hierarchical pathfinding cluster size (tiles)
+    constexpr int HPA_MAX_SINGLE_ENTRANCE = 6;          ///< Longer entrances get a transition at each end
+    constexpr int HPA_REFINE_SEGMENTS = 2;              ///< Abstract hops turned into tiles per query
+    constexpr int HPA_CLUSTERS_PER_TICK = 8;            ///< Clusters of the abstract graph built per tick
 
     // ========================================================================
     // MAP & RENDERING CONSTANTS
@@ -44,6 +61,11 @@ namespace Globals
     constexpr int PLAYER_FOV_Y = 136;                   ///< Render distance Y (screen height + buffer)
     constexpr int DEFAULT_MAP_WIDTH = 40;               ///< Procedural map width (tiles)
     constexpr int DEFAULT_MAP_HEIGHT = 40;              ///< Procedural map height (tiles)
+    constexpr bool PRERENDER_MAP = true;                ///< Draw the map from cached chunk bitmaps instead of tile by tile
+    constexpr int MAP_RENDER_CHUNK_TILES = 8;           ///< Side of a cached map chunk (tiles)
+    constexpr bool ANIMATION_ATLAS = true;              ///< Load sprites and animation frames from the packed atlases when they exist
+    constexpr const char* PLAYER_ATLAS_PATH = "images/player/atlas";    ///< Player animation atlas, next to its .json frame list
+    constexpr const char* MONSTER_ATLAS_PATH = "images/monsters/atlas"; ///< Monster sprite atlas, next to its .json frame list
 
     // Procedural map generation defaults
     constexpr float DEFAULT_OBSTACLE_DENSITY = 0.15f;   ///< 15% of tiles are obstacles
@@ -56,6 +78,7 @@ namespace Globals
     // MONSTER BEHAVIOR CONSTANTS
     // ========================================================================
     constexpr int MONSTER_AWARENESS_RADIUS = 50;        ///< Monster detection range (pixels)
+    constexpr int MONSTER_GRID_CELL_SIZE = 64;          ///< Cell size of the monster hit testing grid (pixels)
     constexpr int MONSTER_SPAWN_RADIUS = 20;            ///< Min distance from player to spawn (tiles)
     constexpr int MONSTER_ATTACK_RANGE = 1;             ///< Melee attack range (tiles)
     constexpr unsigned int MONSTER_MELEE_ATTACK_COOLDOWN = 1000;  ///< Melee attack cooldown (ms)
@@ -70,7 +93,7 @@ namespace Globals
     // ========================================================================
     // SPAWNING CONSTANTS
     // ========================================================================
-    constexpr int MONSTER_MAX_LIVING_COUNT = 10;       ///< Max simultaneous living monsters
+    constexpr int MONSTER_MAX_LIVING_COUNT = 40;       ///< Max simultaneous living monsters
     constexpr int MONSTER_TOTAL_TO_SPAWN = 50;         ///< Total monsters per game
     constexpr int TICKS_BETWEEN_MONSTER_SPAWNS = 60;   ///< Spawn interval (3 seconds @ 20 FPS)
 
@@ -92,6 +115,8 @@ namespace Globals
     constexpr float MONSTER_STATIONARY_PROJECTILE_BASE_DAMAGE = 1.0f; ///< Base damage (stationary)
     constexpr float MONSTER_STATIONARY_PROJECTILE_STRENGTH_MULTIPLIER = 0.3f; ///< Damage per strength
     constexpr float MONSTER_PROJECTILE_MIN_DAMAGE = 0.5f;      ///< Minimum damage floor
+    constexpr unsigned int MONSTER_PROJECTILE_LIFETIME = 3000; ///< Max projectile lifetime (ms)
+    constexpr int ENEMY_PROJECTILE_CAPACITY = 128;             ///< Max simultaneous enemy projectiles per area
 
     // ========================================================================
     // PLAYER CONSTANTS
@@ -104,6 +129,7 @@ namespace Globals
     constexpr unsigned int PLAYER_AUTO_FIRE_COOLDOWN = 1000; ///< Auto-fire cooldown (ms)
     constexpr unsigned int PLAYER_ACTIVITY_THRESHOLD = 500;  ///< Idle threshold for slowdown (ms)
     constexpr float PLAYER_MOVEMENT_SPEED = 5.0f;       ///< Movement speed (pixels/frame)
+    constexpr int PLAYER_MAGIC_CAPACITY = 16;           ///< Max simultaneous player spells and auto-fire shots
 
     // ========================================================================
     // PROGRESSION CONSTANTS
@@ -118,11 +144,25 @@ namespace Globals
     constexpr int HEALTH_BAR_HEIGHT = 4;                 ///< Health bar height (pixels)
     constexpr int HEALTH_BAR_OFFSET_X = -5;              ///< Health bar X offset
     constexpr int HEALTH_BAR_OFFSET_Y = -10;             ///< Health bar Y offset
+    constexpr int DRAW_LIST_CAPACITY = 512;              ///< Max world draw commands per frame, the rest are dropped
+    constexpr int DRAW_BOUNDS_MARGIN = 64;               ///< Pixels around an entity's position its sprite, bars, sparks and death effect stay in
 
     // ========================================================================
     // PERFORMANCE CONSTANTS
     // ========================================================================
     constexpr int GAME_REFRESH_RATE = 20;                ///< Target FPS (20 Hz)
+    constexpr bool RUN_PATHFINDING_BENCHMARK = false;    ///< Log a pathfinding mode comparison at startup (development only)
+    constexpr int PATHFINDING_BENCHMARK_QUERIES = 200;   ///< Random queries per map size and mode
+    constexpr int COLLISION_BENCHMARK_PASSES = 20;       ///< Full map sweeps of collision queries per map size
+    constexpr bool RUN_MONSTER_BENCHMARK = false;        ///< Log area tick timings with many monsters at startup (development only)
+    constexpr int MONSTER_BENCHMARK_COUNT = 500;         ///< Living monsters in the benchmark area, deliberately past MONSTER_MAX_LIVING_COUNT
+    constexpr int MONSTER_BENCHMARK_TICKS = 100;         ///< Area ticks timed by the benchmark
+    constexpr bool RUN_ENTITY_BENCHMARK = false;         ///< Log entity lookup timings once the JSON files are loaded (development only)
+    constexpr int ENTITY_BENCHMARK_PASSES = 1000;        ///< Lookups of every loaded entity per storage
+    constexpr bool RUN_DSTAR_BENCHMARK = false;          ///< Log a D* Lite check against from-scratch searches at startup (development only)
+    constexpr int DSTAR_BENCHMARK_STEPS = 500;           ///< Planner updates per scenario
+    constexpr bool PARTIAL_SCREEN_UPDATES = true;        ///< Only redraw the regions that changed (menus, loading, and the game while the camera holds still)
+    constexpr int RENDER_STATS_LOG_INTERVAL = 0;         ///< Frames between logs of the area render counters, 0 disables (development only)
 
     // ========================================================================
     // FILE PATHS
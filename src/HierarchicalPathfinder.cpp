@@ -0,0 +1,447 @@
+#include "HierarchicalPathfinder.h"
+#include "Globals.h"
+#include "MapCollision.h"
+#include "PathCosts.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+    constexpr unsigned int UNREACHABLE = 0xFFFFFFFF;
+}
+
+bool HierarchicalPathfinder::ContinueBuild(const MapCollision* collider, int clusterBudget)
+{
+    if (collider == nullptr) return false;
+
+    if (staticVersion != collider->getStaticVersion())
+    {
+        // The terrain changed (or we never built), start over
+        width = collider->map_size.x;
+        height = collider->map_size.y;
+        clusterSize = Globals::HPA_CLUSTER_SIZE;
+        clustersX = (width + clusterSize - 1) / clusterSize;
+        clustersY = (height + clusterSize - 1) / clusterSize;
+        staticVersion = collider->getStaticVersion();
+        builtClusters = 0;
+        ready = false;
+        nodes.clear();
+        clusterNodes.assign(static_cast<size_t>(clustersX) * clustersY, std::vector<int>());
+        BuildEntrances(collider);
+    }
+
+    const int clusterCount = clustersX * clustersY;
+    while (clusterBudget-- > 0 && builtClusters < clusterCount)
+    {
+        BuildClusterEdges(collider, builtClusters++);
+    }
+    ready = builtClusters >= clusterCount;
+    return ready;
+}
+
+bool HierarchicalPathfinder::IsReady(const MapCollision* collider) const
+{
+    return ready && collider != nullptr && staticVersion == collider->getStaticVersion();
+}
+
+void HierarchicalPathfinder::BuildEntrances(const MapCollision* collider)
+{
+    for (int cy = 0; cy < clustersY; ++cy)
+    {
+        for (int cx = 0; cx < clustersX; ++cx)
+        {
+            const int x0 = cx * clusterSize;
+            const int y0 = cy * clusterSize;
+            const int x1 = std::min(x0 + clusterSize, width) - 1;
+            const int y1 = std::min(y0 + clusterSize, height) - 1;
+
+            // Border with the cluster on the right, then with the one below.
+            // A run of open tile pairs is one entrance, long runs get a transition at each end.
+            for (int side = 0; side < 2; ++side)
+            {
+                const bool right = side == 0;
+                if (right ? x1 + 1 >= width : y1 + 1 >= height) continue;
+
+                const int first = right ? y0 : x0;
+                const int last = right ? y1 : x1;
+                int runStart = -1;
+                for (int i = first; i <= last + 1; ++i)
+                {
+                    bool open = false;
+                    if (i <= last)
+                    {
+                        open = right ? (collider->isStaticWalkable(x1, i) && collider->isStaticWalkable(x1 + 1, i))
+                                     : (collider->isStaticWalkable(i, y1) && collider->isStaticWalkable(i, y1 + 1));
+                    }
+                    if (open && runStart < 0)
+                    {
+                        runStart = i;
+                    }
+                    else if (!open && runStart >= 0)
+                    {
+                        const int runEnd = i - 1;
+                        const int picks[2] = {runStart, runEnd};
+                        const bool single = runEnd - runStart + 1 < Globals::HPA_MAX_SINGLE_ENTRANCE;
+                        for (int p = 0; p < (single ? 1 : 2); ++p)
+                        {
+                            const int at = single ? (runStart + runEnd) / 2 : picks[p];
+                            if (right) AddTransition({x1, at}, {x1 + 1, at});
+                            else AddTransition({at, y1}, {at, y1 + 1});
+                        }
+                        runStart = -1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::AddTransition(const pdcpp::Point<int> a, const pdcpp::Point<int> b)
+{
+    const int ia = AddNode(a);
+    const int ib = AddNode(b);
+    nodes[ia].edges.push_back({ib, PathCosts::STRAIGHT_COST});
+    nodes[ib].edges.push_back({ia, PathCosts::STRAIGHT_COST});
+}
+
+int HierarchicalPathfinder::AddNode(const pdcpp::Point<int> position)
+{
+    const int cluster = GetClusterOf(position.x, position.y);
+    for (const int index : clusterNodes[cluster])
+    {
+        if (nodes[index].position == position) return index;
+    }
+    nodes.push_back({position, cluster, {}});
+    const int index = static_cast<int>(nodes.size()) - 1;
+    clusterNodes[cluster].push_back(index);
+    return index;
+}
+
+void HierarchicalPathfinder::BuildClusterEdges(const MapCollision* collider, const int cluster)
+{
+    for (const int from : clusterNodes[cluster])
+    {
+        SearchCluster(collider, cluster, nodes[from].position);
+        for (const int to : clusterNodes[cluster])
+        {
+            if (to == from) continue;
+            const unsigned int cost = GetLocalCost(nodes[to].position);
+            if (cost != UNREACHABLE)
+            {
+                nodes[from].edges.push_back({to, cost});
+            }
+        }
+    }
+}
+
+unsigned int HierarchicalPathfinder::SearchCluster(const MapCollision* collider, const int cluster, const pdcpp::Point<int> from)
+{
+    localOrigin = {(cluster % clustersX) * clusterSize, (cluster / clustersX) * clusterSize};
+    const int localWidth = std::min(clusterSize, width - localOrigin.x);
+    const int localHeight = std::min(clusterSize, height - localOrigin.y);
+    localCost.assign(static_cast<size_t>(clusterSize) * clusterSize, UNREACHABLE);
+    open.clear();
+
+    const auto isOpen = [&](const int x, const int y)
+    {
+        return x >= localOrigin.x && y >= localOrigin.y && x < localOrigin.x + localWidth && y < localOrigin.y + localHeight
+               && collider->isStaticWalkable(x, y);
+    };
+    if (!isOpen(from.x, from.y)) return 0;
+
+    unsigned int expanded = 0;
+    const int fromIndex = (from.y - localOrigin.y) * clusterSize + (from.x - localOrigin.x);
+    localCost[fromIndex] = 0;
+    open.push_back({0, fromIndex});
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        const OpenEntry current = open.back();
+        open.pop_back();
+        if (current.cost > localCost[current.index]) continue;
+        expanded++;
+
+        const int cx = localOrigin.x + current.index % clusterSize;
+        const int cy = localOrigin.y + current.index / clusterSize;
+        for (int i = 0; i < PathCosts::NEIGHBOUR_COUNT; ++i)
+        {
+            const int nx = cx + PathCosts::NEIGHBOUR_DX[i];
+            const int ny = cy + PathCosts::NEIGHBOUR_DY[i];
+            if (!isOpen(nx, ny)) continue;
+
+            const bool diagonal = PathCosts::NEIGHBOUR_DX[i] != 0 && PathCosts::NEIGHBOUR_DY[i] != 0;
+            if (diagonal && (!isOpen(cx, ny) || !isOpen(nx, cy))) continue;
+
+            const unsigned int cost = current.cost + (diagonal ? PathCosts::DIAGONAL_COST : PathCosts::STRAIGHT_COST);
+            const int index = (ny - localOrigin.y) * clusterSize + (nx - localOrigin.x);
+            if (cost < localCost[index])
+            {
+                localCost[index] = cost;
+                open.push_back({cost, index});
+                std::push_heap(open.begin(), open.end(), std::greater<>());
+            }
+        }
+    }
+    return expanded;
+}
+
+unsigned int HierarchicalPathfinder::GetLocalCost(const pdcpp::Point<int> position) const
+{
+    const int lx = position.x - localOrigin.x;
+    const int ly = position.y - localOrigin.y;
+    if (lx < 0 || ly < 0 || lx >= clusterSize || ly >= clusterSize) return UNREACHABLE;
+    return localCost[ly * clusterSize + lx];
+}
+
+bool HierarchicalPathfinder::ComputePath(MapCollision* collider, const pdcpp::Point<int>& start, const pdcpp::Point<int>& end,
+                                         std::vector<pdcpp::Point<int>>& path, const int movementType)
+{
+    const unsigned int ticket = BeginPath(collider, start, end, movementType);
+    ContinuePath(collider, ticket, UINT_MAX);
+    return FinishPath(ticket, path);
+}
+
+unsigned int HierarchicalPathfinder::BeginPath(const MapCollision* collider, const pdcpp::Point<int>& start, const pdcpp::Point<int>& end, const int movementType)
+{
+    query = Query();
+    if (++queryTickets == 0) ++queryTickets;
+    query.ticket = queryTickets;
+    query.start = start;
+    query.end = end;
+    query.movementType = movementType;
+    result.clear();
+
+    if (collider == nullptr || collider->isOutsideMap(start.x, start.y) || collider->isOutsideMap(end.x, end.y)) return query.ticket;
+    // The abstract search would visit every node of the start's region before giving up
+    if (movementType == MapCollision::MOVE_NORMAL && !collider->isSameRegion(start, end)) return query.ticket;
+
+    // Queries inside a single cluster, or before the graph is ready, go straight to the collider
+    const bool useGraph = IsReady(collider) && GetClusterOf(start.x, start.y) != GetClusterOf(end.x, end.y);
+    query.stage = useGraph ? Stage::EndCluster : Stage::TilePath;
+    return query.ticket;
+}
+
+bool HierarchicalPathfinder::ContinuePath(MapCollision* collider, const unsigned int ticket, const unsigned int expansions)
+{
+    if (!IsQueryActive(ticket)) return true;
+
+    const bool usesGraph = query.stage == Stage::EndCluster || query.stage == Stage::StartCluster || query.stage == Stage::Abstract;
+    if (usesGraph && !IsReady(collider))
+    {
+        // The terrain changed under the query and the graph is being rebuilt
+        query.stage = Stage::TilePath;
+        query.tileTicket = 0;
+    }
+
+    unsigned int spent = 0;
+    while (query.stage != Stage::Done && spent < expansions)
+    {
+        switch (query.stage)
+        {
+            case Stage::TilePath:
+            {
+                bool done = false;
+                spent += StepTileSearch(collider, query.start, query.end, MapCollision::DEFAULT_PATH_LIMIT, expansions - spent, done);
+                if (done)
+                {
+                    collider->finishPath(query.tileTicket, result);
+                    query.stage = Stage::Done;
+                }
+                break;
+            }
+            case Stage::EndCluster:
+                spent += HookEnd(collider);
+                query.stage = Stage::StartCluster;
+                break;
+            case Stage::StartCluster:
+                spent += HookStart(collider);
+                query.stage = Stage::Abstract;
+                break;
+            case Stage::Abstract:
+                spent += StepAbstract(expansions - spent);
+                break;
+            case Stage::Refine:
+                spent += StepRefine(collider, expansions - spent);
+                break;
+            case Stage::Done:
+                break;
+        }
+    }
+    return query.stage == Stage::Done;
+}
+
+bool HierarchicalPathfinder::FinishPath(const unsigned int ticket, std::vector<pdcpp::Point<int>>& path)
+{
+    path.clear();
+    if (!IsQueryActive(ticket) || query.stage != Stage::Done) return false;
+    path.assign(result.begin(), result.end());
+    query.ticket = 0;
+    return !path.empty();
+}
+
+unsigned int HierarchicalPathfinder::HookEnd(const MapCollision* collider)
+{
+    const int nodeCount = static_cast<int>(nodes.size());
+    bestCost.assign(nodeCount + 1, UNREACHABLE);
+    parent.assign(nodeCount + 1, -1);
+    endCost.assign(nodeCount, UNREACHABLE);
+    lastExpanded = 0;
+
+    // Hook the end into the graph: cost from each node of its cluster
+    const int endCluster = GetClusterOf(query.end.x, query.end.y);
+    const unsigned int expanded = SearchCluster(collider, endCluster, query.end);
+    for (const int index : clusterNodes[endCluster])
+    {
+        endCost[index] = GetLocalCost(nodes[index].position);
+    }
+    return expanded;
+}
+
+unsigned int HierarchicalPathfinder::HookStart(const MapCollision* collider)
+{
+    // And the start: every node of its cluster is a starting point
+    const int startCluster = GetClusterOf(query.start.x, query.start.y);
+    const unsigned int expanded = SearchCluster(collider, startCluster, query.start);
+    open.clear();
+    for (const int index : clusterNodes[startCluster])
+    {
+        const unsigned int cost = GetLocalCost(nodes[index].position);
+        if (cost == UNREACHABLE) continue;
+        bestCost[index] = cost;
+        open.push_back({cost + PathCosts::OctileDistance(nodes[index].position, query.end), index});
+        std::push_heap(open.begin(), open.end(), std::greater<>());
+    }
+    return expanded;
+}
+
+unsigned int HierarchicalPathfinder::StepAbstract(const unsigned int expansions)
+{
+    const int endSlot = static_cast<int>(nodes.size());
+    const pdcpp::Point<int> end = query.end;
+    unsigned int expanded = 0;
+    while (expanded < expansions)
+    {
+        if (open.empty())
+        {
+            FinishAbstract(false);
+            return expanded;
+        }
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        const OpenEntry current = open.back();
+        open.pop_back();
+
+        if (current.index == endSlot)
+        {
+            FinishAbstract(true);
+            return expanded;
+        }
+        const Node& node = nodes[current.index];
+        if (current.cost != bestCost[current.index] + PathCosts::OctileDistance(node.position, end)) continue; // stale entry
+        lastExpanded++;
+        expanded++;
+
+        const auto relax = [&](const int to, const unsigned int cost, const unsigned int heuristic)
+        {
+            if (cost < bestCost[to])
+            {
+                bestCost[to] = cost;
+                parent[to] = current.index;
+                open.push_back({cost + heuristic, to});
+                std::push_heap(open.begin(), open.end(), std::greater<>());
+            }
+        };
+        if (endCost[current.index] != UNREACHABLE)
+        {
+            relax(endSlot, bestCost[current.index] + endCost[current.index], 0);
+        }
+        for (const Edge& edge : node.edges)
+        {
+            relax(edge.to, bestCost[current.index] + edge.cost, PathCosts::OctileDistance(nodes[edge.to].position, end));
+        }
+    }
+    return expanded;
+}
+
+void HierarchicalPathfinder::FinishAbstract(const bool found)
+{
+    query.tileTicket = 0;
+    if (!found)
+    {
+        // No abstract route, the tile search has the final word
+        query.stage = Stage::TilePath;
+        return;
+    }
+
+    const int endSlot = static_cast<int>(nodes.size());
+    waypoints.clear();
+    waypoints.push_back(query.end);
+    for (int index = parent[endSlot]; index >= 0; index = parent[index])
+    {
+        waypoints.push_back(nodes[index].position);
+    }
+    waypoints.push_back(query.start);
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    refined.clear();
+    query.segment = 1;
+    query.from = query.start;
+    query.stage = Stage::Refine;
+}
+
+unsigned int HierarchicalPathfinder::StepTileSearch(MapCollision* collider, const pdcpp::Point<int> from, const pdcpp::Point<int> to,
+                                                    const unsigned int limit, const unsigned int expansions, bool& done)
+{
+    const unsigned int expandedBefore = collider->getPathStats().expanded_nodes;
+    if (query.tileTicket == 0 || collider->continuePath(query.tileTicket, 0) == MapCollision::SEARCH_LOST)
+    {
+        // Not started yet, or another search took the collider's workspace since the last slice
+        query.tileTicket = collider->beginPath(from, to, query.movementType, limit);
+    }
+    done = collider->continuePath(query.tileTicket, expansions) == MapCollision::SEARCH_DONE;
+    return collider->getPathStats().expanded_nodes - expandedBefore;
+}
+
+unsigned int HierarchicalPathfinder::StepRefine(MapCollision* collider, const unsigned int expansions)
+{
+    // Only the first hops are turned into tiles, the caller asks again once it walked them
+    const size_t segments = std::min(static_cast<size_t>(Globals::HPA_REFINE_SEGMENTS), waypoints.size() - 1);
+    unsigned int spent = 0;
+    if (query.segment <= segments)
+    {
+        const pdcpp::Point<int> to = waypoints[query.segment];
+        if (query.from == to)
+        {
+            query.segment++;
+            return 0;
+        }
+
+        const unsigned int limit = static_cast<unsigned int>(clusterSize * clusterSize * 2);
+        bool done = false;
+        spent = StepTileSearch(collider, query.from, to, limit, expansions, done);
+        if (!done) return spent;
+
+        const unsigned int tileTicket = query.tileTicket;
+        query.tileTicket = 0;
+        if (collider->finishPath(tileTicket, segment))
+        {
+            // finishPath stores the path from the end to the start
+            for (auto it = segment.rbegin(); it != segment.rend(); ++it)
+            {
+                if (refined.empty() || !(refined.back() == *it)) refined.push_back(*it);
+            }
+            // Short of `to`, it's blocked by monsters: walk the partial path and try again later
+            if (refined.back() == to)
+            {
+                query.from = to;
+                query.segment++;
+                return spent;
+            }
+        }
+    }
+
+    result.assign(refined.rbegin(), refined.rend());
+    query.stage = Stage::Done;
+    return spent;
+}
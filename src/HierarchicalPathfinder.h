@@ -0,0 +1,152 @@
+#ifndef CARDOBLAST_HIERARCHICALPATHFINDER_H
+#define CARDOBLAST_HIERARCHICALPATHFINDER_H
+
+#include "pdcpp/graphics/Point.h"
+#include <vector>
+
+class MapCollision;
+
+/**
+ * @brief HPA* abstraction of the collision map.
+ *
+ * The map is cut into fixed size clusters (Globals::HPA_CLUSTER_SIZE). Every walkable opening
+ * between two neighbouring clusters becomes an entrance with one abstract node on each side,
+ * and the costs between the nodes of a cluster are cached. Long queries search this small
+ * graph first and only refine the first few abstract hops on the real grid, so their cost
+ * stays bounded by the cluster size instead of the map size.
+ *
+ * The graph only looks at the static layer. It is built a few clusters per call so it can
+ * run across frames once the map is ready, and restarts on its own if the map changes.
+ */
+class HierarchicalPathfinder
+{
+public:
+    HierarchicalPathfinder() = default;
+
+    /**
+     * @brief Build up to `clusterBudget` clusters of the graph.
+     * @return true once the graph matches the collider's current terrain
+     */
+    bool ContinueBuild(const MapCollision* collider, int clusterBudget);
+    [[nodiscard]] bool IsReady(const MapCollision* collider) const;
+    void Invalidate() { ready = false; staticVersion = 0; }
+
+    /**
+     * @brief Same contract as MapCollision::ComputePath, but only the first
+     * Globals::HPA_REFINE_SEGMENTS abstract hops are turned into tiles.
+     *
+     * Queries inside a single cluster (or before the graph is ready) go straight to the collider.
+     */
+    bool ComputePath(MapCollision* collider, const pdcpp::Point<int>& start, const pdcpp::Point<int>& end,
+                     std::vector<pdcpp::Point<int>>& path, int movementType);
+
+    /**
+     * @brief Resumable ComputePath, for the frame budgeted PathScheduler.
+     *
+     * BeginPath sets the query up, ContinuePath works on it for about `expansions` expanded tiles
+     * or abstract nodes, and FinishPath hands over the result. The work is counted in the same unit
+     * as a tile search, and the only step that can't be split is the Dijkstra of one cluster
+     * (at most HPA_CLUSTER_SIZE squared tiles). There is one query at a time: beginning another
+     * one, or calling ComputePath, abandons it and IsQueryActive turns false for its ticket.
+     */
+    unsigned int BeginPath(const MapCollision* collider, const pdcpp::Point<int>& start, const pdcpp::Point<int>& end, int movementType);
+    // true once the query is done. An abandoned ticket is done, without a path.
+    bool ContinuePath(MapCollision* collider, unsigned int ticket, unsigned int expansions);
+    bool FinishPath(unsigned int ticket, std::vector<pdcpp::Point<int>>& path);
+    [[nodiscard]] bool IsQueryActive(unsigned int ticket) const { return ticket != 0 && ticket == query.ticket; }
+
+    [[nodiscard]] int GetClusterOf(int x, int y) const { return (y / clusterSize) * clustersX + (x / clusterSize); }
+    [[nodiscard]] size_t GetNodeCount() const { return nodes.size(); }
+    [[nodiscard]] unsigned int GetLastExpandedCount() const { return lastExpanded; }
+
+private:
+    struct Edge
+    {
+        int to;
+        unsigned int cost;
+    };
+
+    struct Node
+    {
+        pdcpp::Point<int> position;
+        int cluster;
+        std::vector<Edge> edges;
+    };
+
+    struct OpenEntry
+    {
+        unsigned int cost;
+        int index;
+        bool operator>(const OpenEntry& other) const { return cost > other.cost; }
+    };
+
+    void BuildEntrances(const MapCollision* collider);
+    void AddTransition(pdcpp::Point<int> a, pdcpp::Point<int> b);
+    int AddNode(pdcpp::Point<int> position);
+    void BuildClusterEdges(const MapCollision* collider, int cluster);
+
+    enum class Stage
+    {
+        TilePath,     // plain tile search from start to end, when the graph can't help
+        EndCluster,   // costs from the end to the nodes of its cluster
+        StartCluster, // costs from the start to the nodes of its cluster, which seed the abstract search
+        Abstract,     // A* over the abstract graph
+        Refine,       // tile searches along the first abstract hops
+        Done
+    };
+
+    // State of the query run by BeginPath / ContinuePath
+    struct Query
+    {
+        unsigned int ticket = 0;
+        Stage stage = Stage::Done;
+        pdcpp::Point<int> start = {0, 0};
+        pdcpp::Point<int> end = {0, 0};
+        int movementType = 0;
+        unsigned int tileTicket = 0; // collider search of the TilePath or Refine stage, 0 before it starts
+        size_t segment = 1; // next waypoint to refine towards
+        pdcpp::Point<int> from = {0, 0}; // where the segment being refined starts
+        bool found = false;
+    };
+
+    // Dijkstra restricted to one cluster, results go to `localCost`. Returns the tiles expanded.
+    unsigned int SearchCluster(const MapCollision* collider, int cluster, pdcpp::Point<int> from);
+    [[nodiscard]] unsigned int GetLocalCost(pdcpp::Point<int> position) const;
+
+    // Each step returns the tiles or abstract nodes it expanded
+    unsigned int HookEnd(const MapCollision* collider);
+    unsigned int HookStart(const MapCollision* collider);
+    unsigned int StepAbstract(unsigned int expansions);
+    // Runs the collider search of the stage, started on the first call or if another search replaced it
+    unsigned int StepTileSearch(MapCollision* collider, pdcpp::Point<int> from, pdcpp::Point<int> to, unsigned int limit, unsigned int expansions, bool& done);
+    unsigned int StepRefine(MapCollision* collider, unsigned int expansions);
+    void FinishAbstract(bool found);
+
+    std::vector<Node> nodes;
+    std::vector<std::vector<int>> clusterNodes; // abstract node indices per cluster
+    int width = 0;
+    int height = 0;
+    int clusterSize = 1;
+    int clustersX = 0;
+    int clustersY = 0;
+    int builtClusters = 0;
+    unsigned int staticVersion = 0;
+    bool ready = false;
+
+    // scratch buffers reused between searches
+    std::vector<unsigned int> localCost; // cluster sized, row-major
+    pdcpp::Point<int> localOrigin = {0, 0};
+    std::vector<unsigned int> endCost; // per abstract node
+    std::vector<unsigned int> bestCost; // per abstract node, plus one slot for the end
+    std::vector<int> parent; // per abstract node, plus one slot for the end
+    std::vector<OpenEntry> open;
+    std::vector<pdcpp::Point<int>> waypoints; // abstract path, start first
+    std::vector<pdcpp::Point<int>> segment;
+    std::vector<pdcpp::Point<int>> refined; // tiles in walking order
+    std::vector<pdcpp::Point<int>> result; // path of the finished query, end first
+    Query query;
+    unsigned int queryTickets = 0;
+    unsigned int lastExpanded = 0;
+};
+
+#endif //CARDOBLAST_HIERARCHICALPATHFINDER_H
@@ -0,0 +1,114 @@
+#include "HitShape.h"
+#include <algorithm>
+#include <cmath>
+
+HitShape HitShape::Circle(const pdcpp::Point<int> center, const float radius)
+{
+    HitShape shape;
+    shape.type = Type::Circle;
+    shape.from = center;
+    shape.to = center;
+    shape.radius = radius;
+    return shape;
+}
+
+HitShape HitShape::Segment(const pdcpp::Point<int> from, const pdcpp::Point<int> to, const float halfWidth)
+{
+    HitShape shape;
+    shape.type = Type::Segment;
+    shape.from = from;
+    shape.to = to;
+    shape.radius = halfWidth;
+    return shape;
+}
+
+HitShape HitShape::Ring(const pdcpp::Point<int> center, const float innerRadius, const float outerRadius)
+{
+    HitShape shape;
+    shape.type = Type::Ring;
+    shape.from = center;
+    shape.to = center;
+    shape.radius = outerRadius;
+    shape.innerRadius = innerRadius;
+    return shape;
+}
+
+bool HitShape::Contains(const pdcpp::Point<int> point) const
+{
+    const auto px = static_cast<float>(point.x - from.x);
+    const auto py = static_cast<float>(point.y - from.y);
+    switch (type)
+    {
+        case Type::Circle:
+            return px * px + py * py < radius * radius;
+
+        case Type::Segment:
+        {
+            const auto dx = static_cast<float>(to.x - from.x);
+            const auto dy = static_cast<float>(to.y - from.y);
+            const float lengthSquared = dx * dx + dy * dy;
+            if (lengthSquared <= 0.0f) return false;
+
+            // parametric position along the segment, 0 at `from` and 1 at `to`
+            const float t = (px * dx + py * dy) / lengthSquared;
+            if (t < 0.0f || t > 1.0f) return false;
+            return std::abs(dy * px - dx * py) / std::sqrt(lengthSquared) < radius;
+        }
+
+        case Type::Ring:
+        {
+            const float distanceSquared = px * px + py * py;
+            return distanceSquared > innerRadius * innerRadius && distanceSquared < radius * radius;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void HitShape::GetBounds(float& minX, float& minY, float& maxX, float& maxY) const
+{
+    minX = static_cast<float>(std::min(from.x, to.x)) - radius;
+    minY = static_cast<float>(std::min(from.y, to.y)) - radius;
+    maxX = static_cast<float>(std::max(from.x, to.x)) + radius;
+    maxY = static_cast<float>(std::max(from.y, to.y)) + radius;
+}
+
+bool HitShape::MayOverlap(const float minX, const float minY, const float maxX, const float maxY) const
+{
+    switch (type)
+    {
+        case Type::Circle:
+        case Type::Ring:
+        {
+            // closest point of the box to the center
+            const float nearX = std::clamp(static_cast<float>(from.x), minX, maxX) - static_cast<float>(from.x);
+            const float nearY = std::clamp(static_cast<float>(from.y), minY, maxY) - static_cast<float>(from.y);
+            if (nearX * nearX + nearY * nearY > radius * radius) return false;
+            if (type == Type::Circle) return true;
+
+            // a box entirely inside the hole can't hold a hit
+            const float farX = std::max(std::abs(minX - static_cast<float>(from.x)), std::abs(maxX - static_cast<float>(from.x)));
+            const float farY = std::max(std::abs(minY - static_cast<float>(from.y)), std::abs(maxY - static_cast<float>(from.y)));
+            return farX * farX + farY * farY > innerRadius * innerRadius;
+        }
+
+        case Type::Segment:
+        {
+            const auto dx = static_cast<float>(to.x - from.x);
+            const auto dy = static_cast<float>(to.y - from.y);
+            const float length = std::sqrt(dx * dx + dy * dy);
+            if (length <= 0.0f) return false;
+
+            // distance from the box center to the line, against the half width plus half the box diagonal
+            const float halfX = (maxX - minX) * 0.5f;
+            const float halfY = (maxY - minY) * 0.5f;
+            const float centerX = minX + halfX - static_cast<float>(from.x);
+            const float centerY = minY + halfY - static_cast<float>(from.y);
+            return std::abs(dy * centerX - dx * centerY) / length <= radius + std::sqrt(halfX * halfX + halfY * halfY);
+        }
+
+        default:
+            return false;
+    }
+}
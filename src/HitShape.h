@@ -0,0 +1,43 @@
+#ifndef CARDOBLAST_HITSHAPE_H
+#define CARDOBLAST_HITSHAPE_H
+
+#include "pdcpp/graphics/Point.h"
+
+/**
+ * @brief Area a projectile deals damage in, tested against entity positions.
+ *
+ * Circle: `from` is the center and `radius` the radius.
+ * Segment: from `from` to `to`, `radius` is the half width. Points projecting beyond the ends miss.
+ * Ring: `from` is the center, hits lie strictly between `innerRadius` and `radius`.
+ */
+struct HitShape
+{
+    enum class Type
+    {
+        None,
+        Circle,
+        Segment,
+        Ring
+    };
+
+    Type type = Type::None;
+    pdcpp::Point<int> from = {0, 0};
+    pdcpp::Point<int> to = {0, 0};
+    float radius = 0.0f;
+    float innerRadius = 0.0f;
+
+    static HitShape Circle(pdcpp::Point<int> center, float radius);
+    static HitShape Segment(pdcpp::Point<int> from, pdcpp::Point<int> to, float halfWidth);
+    static HitShape Ring(pdcpp::Point<int> center, float innerRadius, float outerRadius);
+
+    // Narrow phase, exact test of a single point
+    [[nodiscard]] bool Contains(pdcpp::Point<int> point) const;
+
+    // Broad phase, bounding box in pixels (inclusive)
+    void GetBounds(float& minX, float& minY, float& maxX, float& maxY) const;
+
+    // Conservative test against an axis aligned box, false only if no point of the box can be inside
+    [[nodiscard]] bool MayOverlap(float minX, float minY, float maxX, float maxY) const;
+};
+
+#endif //CARDOBLAST_HITSHAPE_H
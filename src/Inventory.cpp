@@ -38,14 +38,14 @@ void Inventory::Add(const unsigned int itemId, EntityManager* entityManager, con
 {
     for (int i = 0; i < count; i++)
     {
-        std::shared_ptr<void> item = entityManager->GetEntity(itemId);
+        std::shared_ptr<Item> item = entityManager->GetItem(itemId);
 
         if (item == nullptr)
         {
             Log::Error("Item with ID %d not found", itemId);
             continue;
         }
-        items.push_back(std::static_pointer_cast<Item>(item));
+        items.push_back(item);
         //Log::Info("Added %s to inventory.", items.back()->GetName());
     }
 }
@@ -42,6 +42,8 @@ template void Log::Info<>(const char*, float, int);
 template void Log::Info<>(const char*, float, int, int);
 template void Log::Info<>(const char*, int, float);
 template void Log::Info<>(const char*, int, int, int);
+template void Log::Info<>(const char*, int, int, int, int);
+template void Log::Info<>(const char*, int, int, int, int, int);
 template void Log::Info<>(const char*, char const*);
 template void Log::Info<>(const char*, char const*, unsigned int);
 template void Log::Info<>(const char*, unsigned int);
@@ -49,6 +51,8 @@ template void Log::Info<>(const char*, unsigned int, int);
 template void Log::Info<>(const char*, unsigned int, unsigned int);
 template void Log::Info<>(const char*, unsigned int, char*);
 template void Log::Info<>(const char*, char const*, char const*);
+template void Log::Info<>(const char*, char const*, int, int);
+template void Log::Info<>(const char*, char const*, unsigned int, int, int, int);
 template void Log::Info<>(const char*, unsigned int, char*, char*);
 template void Log::Info<>(const char*, unsigned int, char*, char*, int);
 template void Log::Info<>(const char*, unsigned int, char*, const char*);
@@ -63,6 +67,12 @@ template void Log::Info<>(char const*, PDMenuItem*);
 template void Log::Info<>(char const*, unsigned int, char const*, unsigned int);
 template void Log::Info<>(char const*, int, int, unsigned long);
 template void Log::Info<>(char const*, int, int, unsigned int);
+template void Log::Info<>(char const*, int, int, char const*, char const*, unsigned int, unsigned int, unsigned int, int, int);
+template void Log::Info<>(char const*, int, int, unsigned int, unsigned int, int);
+template void Log::Info<>(char const*, char const*, int, int, int, int);
+template void Log::Info<>(char const*, char const*, int, int, int);
+template void Log::Info<>(char const*, int, int, int, char const*);
+template void Log::Info<>(char const*, char const*, int, int, float, float, int, int);
 
 template void Log::Error<>(const char*);
 template void Log::Error<>(const char*, int);
@@ -88,3 +98,4 @@ template void Log::Error<>(char const*, unsigned long);
 template void Log::Error<>(char const*, unsigned int, char const*, char const*);
 template void Log::Error<>(char const*, int, unsigned long);
 template void Log::Error<>(char const*, int, unsigned int);
+template void Log::Error<>(char const*, char const*, int);
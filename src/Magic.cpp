@@ -3,21 +3,28 @@
 //
 
 #include "Magic.h"
-#include "Area.h"
 #include "pdcpp/core/GlobalPlaydateAPI.h"
 
 
-Magic::Magic(pdcpp::Point<int> Position, std::weak_ptr<Player> _player):
-position(Position), player(std::move(_player))
+Magic::Magic(pdcpp::Point<int> Position, Player* _player):
+position(Position), player(_player)
 {
     isAlive = true;
     elapsedTime = 0;
     bornTime = pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds();
 }
 
-void Magic::Update(const std::shared_ptr<Area>& area)
+void Magic::Update()
 {
-    if(!isAlive) return;
+    if(!Age()) return;
+
+    HandleInput();
+    // Draw() is run by the frame's DrawList, on the projectile layer
+    // Damage is dealt afterwards by the area's CollisionPhase, see GetHitShape()
+}
+bool Magic::Age()
+{
+    if(!isAlive) return false;
 
     unsigned int currentTime = pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds();
     elapsedTime = currentTime - bornTime;
@@ -25,9 +32,7 @@ void Magic::Update(const std::shared_ptr<Area>& area)
     {
         Terminate();
     }
-    HandleInput();
-    // Draw() is now called separately in Player::DrawMagic() to ensure proper rendering order
-    Damage(area);
+    return true;
 }
 void Magic::Terminate()
 {
@@ -41,7 +46,11 @@ void Magic::Draw() const
 {
 
 }
-void Magic::Damage(const std::shared_ptr<Area>& area)
+HitShape Magic::GetHitShape() const
+{
+    return {};
+}
+void Magic::OnHit(Monster& monster)
 {
-    // Implement damage logic here
+
 }
\ No newline at end of file
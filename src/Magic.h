@@ -6,27 +6,32 @@
 #define CARDOBLAST_MAGIC_H
 
 
+#include "HitShape.h"
 #include "pdcpp/graphics/Point.h"
-#include <memory>
 
-class Area;
+class Monster;
 class Player;
 
 class Magic{
 public:
     Magic() = delete;
-    explicit Magic(pdcpp::Point<int> Position, std::weak_ptr<Player> player);
+    explicit Magic(pdcpp::Point<int> Position, Player* player);
     bool operator==(const Magic& other) const {return this == &other;}
 
-    void Update(const std::shared_ptr<Area>& area);
+    void Update();
+    // Advance the lifetime. Returns false if the magic was already dead.
+    bool Age();
     virtual void Draw() const;
     virtual void Terminate();
     virtual void HandleInput();
-    virtual void Damage(const std::shared_ptr<Area>& area);
+    // Where the magic deals damage this tick. Hits are resolved by the area's CollisionPhase.
+    [[nodiscard]] virtual HitShape GetHitShape() const;
+    // Called for every monster inside the hit shape
+    virtual void OnHit(Monster& monster);
     [[nodiscard]] bool IsAlive() const{return isAlive;}
 
 protected:
-    std::weak_ptr<Player> player;
+    Player* player; // the caster, who owns the magic and so outlives it
     bool isAlive = false;
     unsigned int bornTime;
     unsigned int iLifetime{}; //milliseconds
@@ -0,0 +1,51 @@
+#include "MagicStore.h"
+#include "Globals.h"
+
+MagicStore::MagicStore()
+{
+    magic.reserve(Globals::PLAYER_MAGIC_CAPACITY);
+}
+
+void MagicStore::Update()
+{
+    for (size_t i = 0; i < magic.size();)
+    {
+        const bool alive = std::visit([](const auto& spell) { return spell.IsAlive(); }, magic[i]);
+        if (!alive)
+        {
+            if (i + 1 != magic.size())
+            {
+                magic[i] = std::move(magic.back());
+            }
+            magic.pop_back();
+            continue;
+        }
+        // Same steps as Magic::Update, but HandleInput is called on the final type
+        std::visit([](auto& spell)
+        {
+            if (spell.Age()) spell.HandleInput();
+        }, magic[i]);
+        ++i;
+    }
+}
+
+void MagicStore::Draw() const
+{
+    for (const PlayerMagic& spell : magic)
+    {
+        std::visit([](const auto& alternative)
+        {
+            if (alternative.IsAlive()) alternative.Draw();
+        }, spell);
+    }
+}
+
+HitShape MagicStore::GetHitShape(const int index) const
+{
+    return std::visit([](const auto& spell) { return spell.GetHitShape(); }, magic[index]);
+}
+
+void MagicStore::OnHit(const int index, Monster& monster)
+{
+    std::visit([&monster](auto& spell) { spell.OnHit(monster); }, magic[index]);
+}
@@ -0,0 +1,64 @@
+#ifndef CARDOBLAST_MAGICSTORE_H
+#define CARDOBLAST_MAGICSTORE_H
+
+#include "AutoProjectile.h"
+#include "Beam.h"
+#include "Globals.h"
+#include "HitShape.h"
+#include "OrbitingProjectiles.h"
+#include "Projectile.h"
+#include <utility>
+#include <variant>
+#include <vector>
+
+class Monster;
+
+/**
+ * @brief The player's live magic, stored by value in one contiguous array.
+ *
+ * Every kind of player magic is an alternative of the variant, so a cast constructs the spell
+ * in place instead of allocating it, and the loops go through std::visit on final classes
+ * instead of virtual calls. The array is reserved once for Globals::PLAYER_MAGIC_CAPACITY
+ * spells and never grows: a cast over capacity is dropped and counted.
+ *
+ * Dead magic is removed by moving the last one into its place, so indices are only stable
+ * until the next Update.
+ */
+class MagicStore
+{
+public:
+    using PlayerMagic = std::variant<Beam, Projectile, OrbitingProjectiles, AutoProjectile>;
+
+    MagicStore();
+
+    // Construct a spell of type T in place. Returns false if the store is full.
+    template<typename T, typename... Args>
+    bool Launch(Args&&... args)
+    {
+        if (IsFull())
+        {
+            dropped++;
+            return false;
+        }
+        magic.emplace_back(std::in_place_type<T>, std::forward<Args>(args)...);
+        return true;
+    }
+
+    // Remove the magic that died last tick, then update the rest
+    void Update();
+    void Draw() const;
+    void Clear() { magic.clear(); }
+
+    [[nodiscard]] HitShape GetHitShape(int index) const;
+    void OnHit(int index, Monster& monster);
+
+    [[nodiscard]] int Size() const { return static_cast<int>(magic.size()); }
+    [[nodiscard]] bool IsFull() const { return Size() >= Globals::PLAYER_MAGIC_CAPACITY; }
+    [[nodiscard]] int GetDroppedCount() const { return dropped; } // casts refused because the store was full
+
+private:
+    std::vector<PlayerMagic> magic;
+    int dropped = 0;
+};
+
+#endif //CARDOBLAST_MAGICSTORE_H
@@ -24,11 +24,14 @@ FLARE.  If not, see http://www.gnu.org/licenses/
  * Handle collisions between objects and the map
  */
 
-#include "AStarContainer.h"
 #include "AStarNode.h"
 #include "MapCollision.h"
+#include "PathCosts.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <climits>
+#include <cstdlib>
 #include <math.h>
 #include <cassert>
 #include <cstring>
@@ -36,31 +39,50 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 // this value is used to determine the greatest possible position within a tile before transitioning to the next tile
 // so if an entity has a position of (1-MIN_TILE_GAP, 0) and moves to the east, they will move to (1,0)
 const float MapCollision::MIN_TILE_GAP = 0.001f;
+const unsigned short MapCollision::NO_REGION;
 
 MapCollision::MapCollision()
 	: has_empty_tile(false)
+	, astar_nodes(0, 0)
+	, astar_open(0, 0, 0)
+	, astar_close(0, 0, 0)
+	, astar_buckets(0, 0, 0)
+	, open_list(OPEN_LIST_BUCKETS)
+	, search_tickets(0)
+	, region_count(0)
 	, map_size({0,0})
+	, static_version(0)
+	, tile_changes(TILE_CHANGE_LOG_SIZE, pdcpp::Point<int>(0, 0))
+	, tile_change_count(0)
 {
-	colmap.resize(1);
-	colmap[0].resize(1);
 }
 
+// shared by every instance, so a new collider never reuses the version of an old one
+static unsigned int static_version_counter = 0;
+
 void MapCollision::SetMap(const Map_Layer& _colmap, unsigned short w, unsigned short h) {
 	has_empty_tile = false;
 
-	colmap.resize(w);
-	for (unsigned i=0; i<w; ++i) {
-		colmap[i].resize(h);
+	const size_t tiles = static_cast<size_t>(w) * h;
+	static_tiles.assign(_colmap.begin(), _colmap.begin() + tiles);
+	for (unsigned char& tile : static_tiles) {
+		// entity markers don't belong to the terrain
+		if (tile > MAP_ONLY_ALT)
+			tile = BLOCKS_NONE;
+		if (tile == BLOCKS_NONE)
+			has_empty_tile = true;
 	}
-	for (unsigned i=0; i<w; i++)
-		for (unsigned j=0; j<h; j++) {
-			colmap[i][j] = _colmap[i][j];
-			if (colmap[i][j] == 0)
-				has_empty_tile = true;
-		}
+	occupancy.assign(tiles, 0);
+	ally_occupancy.assign(tiles, 0);
 
 	map_size.x = w;
 	map_size.y = h;
+	static_version = ++static_version_counter;
+	// the workspace is resized on the next query, a search in progress can't resume
+	search = SearchState();
+
+	buildJumpDistances();
+	buildRegions();
 }
 
 int sgn(float f) {
@@ -226,7 +248,8 @@ bool MapCollision::isWall(const float& x, const float& y) const {
 	if (isTileOutsideMap(tile_x, tile_y)) return true;
 
 	// collision type check
-	return (colmap[tile_x][tile_y] == BLOCKS_ALL || colmap[tile_x][tile_y] == BLOCKS_ALL_HIDDEN);
+	const unsigned char tile = static_tiles[tileIndex(tile_x, tile_y)];
+	return (tile == BLOCKS_ALL || tile == BLOCKS_ALL_HIDDEN);
 }
 
 /**
@@ -236,31 +259,44 @@ bool MapCollision::isValidTile(const int& tile_x, const int& tile_y, int movemen
 	// outside the map isn't valid
 	if (isTileOutsideMap(tile_x,tile_y)) return false;
 
+	const size_t index = tileIndex(tile_x, tile_y);
 	if (collide_type == ENTITY_COLLIDE_ALL) {
-		if (colmap[tile_x][tile_y] == BLOCKS_ENEMIES)
-			return false;
-		if (colmap[tile_x][tile_y] == BLOCKS_ENTITIES)
+		if (occupancy[index] != 0)
 			return false;
 	}
 	else if (collide_type == ENTITY_COLLIDE_HERO) {
-		if (colmap[tile_x][tile_y] == BLOCKS_ENEMIES)
-			return true;
+		// the hero can pass through allies
+		if (occupancy[index] != ally_occupancy[index])
+			return false;
 	}
 
 	// intangible creatures can be everywhere
 	if (movement_type == MOVE_INTANGIBLE)
 		return true;
 
+	const unsigned char tile = static_tiles[index];
+
 	// flying creatures can't be in walls
 	if (movement_type == MOVE_FLYING) {
-		return (!(colmap[tile_x][tile_y] == BLOCKS_ALL || colmap[tile_x][tile_y] == BLOCKS_ALL_HIDDEN));
+		return (!(tile == BLOCKS_ALL || tile == BLOCKS_ALL_HIDDEN));
 	}
 
-	if (colmap[tile_x][tile_y] == MAP_ONLY || colmap[tile_x][tile_y] == MAP_ONLY_ALT)
+	if (tile == MAP_ONLY || tile == MAP_ONLY_ALT)
 		return true;
 
 	// normal creatures can only be in empty spaces
-	return (colmap[tile_x][tile_y] == BLOCKS_NONE);
+	return (tile == BLOCKS_NONE);
+}
+
+/**
+ * Can a normal walker ever stand on this tile?
+ * Only the static layer is considered, tiles taken by entities count as walkable.
+ */
+bool MapCollision::isStaticWalkable(int tile_x, int tile_y) const {
+	if (isTileOutsideMap(tile_x, tile_y)) return false;
+
+	const unsigned char tile = static_tiles[tileIndex(tile_x, tile_y)];
+	return tile == BLOCKS_NONE || tile == MAP_ONLY || tile == MAP_ONLY_ALT;
 }
 
 /**
@@ -308,10 +344,41 @@ bool MapCollision::lineCheck(const float& x1, const float& y1, const float& x2,
 		}
 	}
 	else if (check_type == CHECK_MOVEMENT) {
-		for (int i=0; i<steps; i++) {
-			x += step_x;
-			y += step_y;
-			if (!isValidPosition(x, y, movement_type, ENTITY_COLLIDE_ALL))
+		// Walk every tile the line crosses. Sampling once per step (as for sight) can skip the tile
+		// where the line changes row between two samples, and paths are smoothed with this check.
+		int tile_x = int(x1);
+		int tile_y = int(y1);
+		const int end_x = int(x2);
+		const int end_y = int(y2);
+		const int dir_x = x2 > x1 ? 1 : -1;
+		const int dir_y = y2 > y1 ? 1 : -1;
+		const float delta_x = dx > 0 ? 1.0f / dx : FLT_MAX;
+		const float delta_y = dy > 0 ? 1.0f / dy : FLT_MAX;
+		float next_x = dx > 0 ? (dir_x > 0 ? float(tile_x + 1) - x1 : x1 - float(tile_x)) * delta_x : FLT_MAX;
+		float next_y = dy > 0 ? (dir_y > 0 ? float(tile_y + 1) - y1 : y1 - float(tile_y)) * delta_y : FLT_MAX;
+
+		for (int tiles = abs(end_x - tile_x) + abs(end_y - tile_y); tiles > 0 && (tile_x != end_x || tile_y != end_y); --tiles) {
+			if (fabs(next_x - next_y) < 0.0001f) {
+				// through a corner, the mover may clip either side tile
+				if (!isValidTile(tile_x + dir_x, tile_y, movement_type, ENTITY_COLLIDE_ALL)
+					|| !isValidTile(tile_x, tile_y + dir_y, movement_type, ENTITY_COLLIDE_ALL))
+					return false;
+				tile_x += dir_x;
+				tile_y += dir_y;
+				next_x += delta_x;
+				next_y += delta_y;
+				--tiles;
+			}
+			else if (next_x < next_y) {
+				tile_x += dir_x;
+				next_x += delta_x;
+			}
+			else {
+				tile_y += dir_y;
+				next_y += delta_y;
+			}
+			const int collide_type = (tile_x == end_x && tile_y == end_y) ? ENTITY_COLLIDE_NONE : ENTITY_COLLIDE_ALL;
+			if (!isValidTile(tile_x, tile_y, movement_type, collide_type))
 				return false;
 		}
 	}
@@ -329,21 +396,8 @@ bool MapCollision::lineOfMovement(const float& x1, const float& y1, const float&
 	// intangible entities can always move
 	if (movement_type == MOVE_INTANGIBLE) return true;
 
-	// if the target is blocking, clear it temporarily
-	int tile_x = int(x2);
-	int tile_y = int(y2);
-	bool target_blocks = false;
-	int target_blocks_type = colmap[tile_x][tile_y];
-	if (colmap[tile_x][tile_y] == BLOCKS_ENTITIES || colmap[tile_x][tile_y] == BLOCKS_ENEMIES) {
-		target_blocks = true;
-		unblock(x2,y2);
-	}
-
-	bool has_movement = lineCheck(x1, y1, x2, y2, CHECK_MOVEMENT, movement_type);
-
-	if (target_blocks) block(x2,y2, target_blocks_type == BLOCKS_ENEMIES);
-	return has_movement;
-
+	// the target tile may be taken by an entity (lineCheck ignores occupancy there)
+	return lineCheck(x1, y1, x2, y2, CHECK_MOVEMENT, movement_type);
 }
 
 /**
@@ -375,125 +429,560 @@ bool MapCollision::isFacing(const float& x1, const float& y1, char direction, co
 }
 
 /**
-* Compute a path from (x1,y1) to (x2,y2)
-* Store waypoint inside path
-* limit is the maximum number of explored node
-* @return true if a path is found
-*/
-bool MapCollision::ComputePath(const pdcpp::Point<int>& start_pos, const pdcpp::Point<int>& end_pos, std::vector<pdcpp::Point<int>> &path, int movement_type, unsigned int limit) {
+ * Get the search workspace ready for a new query.
+ * Memory is only allocated the first time a map of a given size is searched.
+ */
+void MapCollision::prepareSearch(unsigned int limit) {
+	const unsigned int w = static_cast<unsigned int>(map_size.x);
+	const unsigned int h = static_cast<unsigned int>(map_size.y);
+
+	if (astar_nodes.Resize(w, h))
+		path_stats.allocations++;
+	if (astar_close.Resize(w, h))
+		path_stats.allocations++;
+	astar_close.Clear(limit);
+
+	// only the open list in use is sized, the other one stays empty
+	if (open_list == OPEN_LIST_BUCKETS) {
+		if (astar_buckets.Resize(w, h))
+			path_stats.allocations++;
+		astar_buckets.Clear(limit);
+	}
+	else {
+		if (astar_open.Resize(w, h))
+			path_stats.allocations++;
+		astar_open.Clear(limit);
+	}
+}
 
-	if (isOutsideMap(end_pos.x, end_pos.y)) return false;
+/*
+ * Jump point search
+ *
+ * Diagonal moves never cut corners, so both orthogonal tiles of a diagonal step must be free.
+ * Directions are indexed N, NE, E, SE, S, SW, W, NW.
+ */
+static const int jump_dir_count = 8;
+static const int jump_dir_x[jump_dir_count] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int jump_dir_y[jump_dir_count] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+static int jumpDirIndex(int dx, int dy) {
+	for (int i = 0; i < jump_dir_count; ++i) {
+		if (jump_dir_x[i] == dx && jump_dir_y[i] == dy)
+			return i;
+	}
+	return 0;
+}
 
-	// default limit set to 10% of the total map size
-	if (limit == 0)
-		limit = (map_size.x * map_size.y) / 10;
+bool MapCollision::isJumpWalkable(int x, int y, int movement_type, bool static_only) const {
+	if (static_only)
+		return isStaticWalkable(x, y);
+	return isValidTile(x, y, movement_type, ENTITY_COLLIDE_ALL);
+}
 
-	// path must be empty
-	if (!path.empty())
-		path.clear();
+/**
+ * Does moving straight into (x,y) along (dx,dy) reveal a neighbour that can't be reached
+ * as cheaply without going through (x,y)?
+ */
+bool MapCollision::isForcedJump(int x, int y, int dx, int dy, int movement_type, bool static_only) const {
+	if (dx != 0) {
+		return (isJumpWalkable(x, y - 1, movement_type, static_only) && !isJumpWalkable(x - dx, y - 1, movement_type, static_only))
+			|| (isJumpWalkable(x, y + 1, movement_type, static_only) && !isJumpWalkable(x - dx, y + 1, movement_type, static_only));
+	}
+	return (isJumpWalkable(x - 1, y, movement_type, static_only) && !isJumpWalkable(x - 1, y - dy, movement_type, static_only))
+		|| (isJumpWalkable(x + 1, y, movement_type, static_only) && !isJumpWalkable(x + 1, y - dy, movement_type, static_only));
+}
 
-	// convert start & end to MapCollision precision
-    pdcpp::Point<int> start(start_pos);
-    pdcpp::Point<int> end(end_pos);
-
-	// if the target square has an entity, temporarily clear it to compute the path
-	bool target_blocks = false;
-	int target_blocks_type = colmap[end.x][end.y];
-	/*
-	if (colmap[end.x][end.y] == BLOCKS_ENTITIES || colmap[end.x][end.y] == BLOCKS_ENEMIES) {
-		target_blocks = true;
-		unblock(end_pos.x, end_pos.y);
-	}
-	*/
-    pdcpp::Point<int> current = start;
-	AStarNode* node = new AStarNode(start);
-	node->setActualCost(0);
-    node->setEstimatedCost(start.distance(end));
-	node->setParent(current);
+/**
+ * Fill the JPS+ table. Each row/column/diagonal is swept backwards so every tile reuses
+ * the value of the tile after it, keeping the build linear in the map size.
+ */
+void MapCollision::buildJumpDistances() {
+	const int w = map_size.x;
+	const int h = map_size.y;
+	jump_distances.assign(static_cast<size_t>(w) * h * jump_dir_count, 0);
+
+	// straight directions first, the diagonals are defined in terms of them
+	for (int pass = 0; pass < 2; ++pass) {
+		for (int dir = 0; dir < jump_dir_count; ++dir) {
+			const int dx = jump_dir_x[dir];
+			const int dy = jump_dir_y[dir];
+			const bool diagonal = dx != 0 && dy != 0;
+			if (diagonal != (pass == 1))
+				continue;
+
+			for (int j = 0; j < h; ++j) {
+				const int y = dy > 0 ? h - 1 - j : j;
+				for (int i = 0; i < w; ++i) {
+					const int x = dx > 0 ? w - 1 - i : i;
+					if (!isStaticWalkable(x, y))
+						continue;
+
+					const int nx = x + dx;
+					const int ny = y + dy;
+					short dist = 0;
+					if (!isStaticWalkable(nx, ny) || (diagonal && (!isStaticWalkable(nx, y) || !isStaticWalkable(x, ny)))) {
+						dist = 0;
+					}
+					else if (diagonal ? (getJumpDistance(nx, ny, jumpDirIndex(dx, 0)) > 0 || getJumpDistance(nx, ny, jumpDirIndex(0, dy)) > 0)
+									  : isForcedJump(nx, ny, dx, dy, MOVE_NORMAL, true)) {
+						dist = 1;
+					}
+					else {
+						const short next = getJumpDistance(nx, ny, dir);
+						dist = next > 0 ? static_cast<short>(next + 1) : static_cast<short>(next - 1);
+					}
+					jump_distances[(static_cast<size_t>(y) * w + x) * jump_dir_count + dir] = dist;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Flood fill the static layer into regions. A diagonal step only links two tiles when both
+ * tiles beside it are walkable too, the no corner cutting rule of JPS, the flow field, HPA*
+ * and D* Lite, so none of them can reach a target in another region.
+ * Plain A* neighbours do cut corners, so A* could squeeze between two regions through a
+ * diagonal gap. That path is rejected on purpose: isSameRegion refuses it before searching,
+ * and monsters never get a route the other modes would call unreachable.
+ */
+void MapCollision::buildRegions() {
+	const int w = map_size.x;
+	const int h = map_size.y;
+	region_labels.assign(static_cast<size_t>(w) * h, NO_REGION);
+	region_count = 0;
+
+	std::vector<int> open;
+	for (int y = 0; y < h; ++y) {
+		for (int x = 0; x < w; ++x) {
+			const size_t seed = static_cast<size_t>(y) * w + x;
+			if (region_labels[seed] != NO_REGION || !isStaticWalkable(x, y))
+				continue;
+
+			// past the label range the remaining regions share the last label, they just aren't told apart
+			const unsigned short label = region_count < USHRT_MAX ? ++region_count : region_count;
+			region_labels[seed] = label;
+			open.push_back(static_cast<int>(seed));
+			while (!open.empty()) {
+				const int cx = open.back() % w;
+				const int cy = open.back() / w;
+				open.pop_back();
+
+				for (int dir = 0; dir < PathCosts::NEIGHBOUR_COUNT; ++dir) {
+					const int nx = cx + PathCosts::NEIGHBOUR_DX[dir];
+					const int ny = cy + PathCosts::NEIGHBOUR_DY[dir];
+					if (!isStaticWalkable(nx, ny))
+						continue;
+					// no corner cutting, see above
+					if (nx != cx && ny != cy && (!isStaticWalkable(nx, cy) || !isStaticWalkable(cx, ny)))
+						continue;
+
+					const size_t index = static_cast<size_t>(ny) * w + nx;
+					if (region_labels[index] == NO_REGION) {
+						region_labels[index] = label;
+						open.push_back(static_cast<int>(index));
+					}
+				}
+			}
+		}
+	}
+}
+
+unsigned short MapCollision::getRegion(int x, int y) const {
+	if (isTileOutsideMap(x, y) || region_labels.empty()) return NO_REGION;
+	return region_labels[static_cast<size_t>(y) * map_size.x + x];
+}
+
+/**
+ * Can a normal walker standing on `from` ever reach `to`?
+ * A start outside every region (e.g. inside a wall) is unknown, so it isn't rejected.
+ */
+bool MapCollision::isSameRegion(const pdcpp::Point<int>& from, const pdcpp::Point<int>& to) const {
+	const unsigned short from_region = getRegion(from.x, from.y);
+	if (from_region == NO_REGION) return true;
+	return from_region == getRegion(to.x, to.y);
+}
+
+short MapCollision::getJumpDistance(int x, int y, int dir) const {
+	if (isTileOutsideMap(x, y)) return 0;
+	return jump_distances[(static_cast<size_t>(y) * map_size.x + x) * jump_dir_count + dir];
+}
+
+/**
+ * Directions worth searching from pos, given the direction we arrived from.
+ * The start node (pos == parent) searches every direction.
+ */
+int MapCollision::getJumpDirections(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent, int movement_type, bool static_only, AStarNeighbours& dirs) const {
+	int count = 0;
+	const int x = pos.x;
+	const int y = pos.y;
+
+	if (pos == parent) {
+		for (int i = 0; i < jump_dir_count; ++i) {
+			const int dx = jump_dir_x[i];
+			const int dy = jump_dir_y[i];
+			if (!isJumpWalkable(x + dx, y + dy, movement_type, static_only))
+				continue;
+			if (dx != 0 && dy != 0 && (!isJumpWalkable(x + dx, y, movement_type, static_only) || !isJumpWalkable(x, y + dy, movement_type, static_only)))
+				continue;
+			dirs[count++] = pdcpp::Point<int>(dx, dy);
+		}
+		return count;
+	}
+
+	const int dx = sgn(static_cast<float>(x - parent.x));
+	const int dy = sgn(static_cast<float>(y - parent.y));
+
+	if (dx != 0 && dy != 0) {
+		const bool vertical = isJumpWalkable(x, y + dy, movement_type, static_only);
+		const bool horizontal = isJumpWalkable(x + dx, y, movement_type, static_only);
+		if (vertical) dirs[count++] = pdcpp::Point<int>(0, dy);
+		if (horizontal) dirs[count++] = pdcpp::Point<int>(dx, 0);
+		if (vertical && horizontal && isJumpWalkable(x + dx, y + dy, movement_type, static_only))
+			dirs[count++] = pdcpp::Point<int>(dx, dy);
+	}
+	else if (dx != 0) {
+		const bool next = isJumpWalkable(x + dx, y, movement_type, static_only);
+		const bool top = isJumpWalkable(x, y - 1, movement_type, static_only);
+		const bool bottom = isJumpWalkable(x, y + 1, movement_type, static_only);
+		if (next) {
+			dirs[count++] = pdcpp::Point<int>(dx, 0);
+			if (top) dirs[count++] = pdcpp::Point<int>(dx, -1);
+			if (bottom) dirs[count++] = pdcpp::Point<int>(dx, 1);
+		}
+		if (top) dirs[count++] = pdcpp::Point<int>(0, -1);
+		if (bottom) dirs[count++] = pdcpp::Point<int>(0, 1);
+	}
+	else {
+		const bool next = isJumpWalkable(x, y + dy, movement_type, static_only);
+		const bool left = isJumpWalkable(x - 1, y, movement_type, static_only);
+		const bool right = isJumpWalkable(x + 1, y, movement_type, static_only);
+		if (next) {
+			dirs[count++] = pdcpp::Point<int>(0, dy);
+			if (left) dirs[count++] = pdcpp::Point<int>(-1, dy);
+			if (right) dirs[count++] = pdcpp::Point<int>(1, dy);
+		}
+		if (left) dirs[count++] = pdcpp::Point<int>(-1, 0);
+		if (right) dirs[count++] = pdcpp::Point<int>(1, 0);
+	}
+	return count;
+}
+
+/**
+ * Walk from pos along (dx,dy) until a jump point, the end, or a wall is found
+ * @return true if jump_point was set
+ */
+bool MapCollision::jump(pdcpp::Point<int> pos, int dx, int dy, const pdcpp::Point<int>& end, int movement_type, pdcpp::Point<int>& jump_point) const {
+	const bool diagonal = dx != 0 && dy != 0;
+	pdcpp::Point<int> unused(0, 0);
+
+	while (true) {
+		if (diagonal && (!isJumpWalkable(pos.x + dx, pos.y, movement_type, false) || !isJumpWalkable(pos.x, pos.y + dy, movement_type, false)))
+			return false;
 
-	AStarContainer open(map_size.x, map_size.y, limit);
-	AStarCloseContainer close(map_size.x, map_size.y, limit);
+		pos.x += dx;
+		pos.y += dy;
+		if (!isJumpWalkable(pos.x, pos.y, movement_type, false))
+			return false;
+
+		if (pos == end || (diagonal ? (jump(pos, dx, 0, end, movement_type, unused) || jump(pos, 0, dy, end, movement_type, unused))
+									: isForcedJump(pos.x, pos.y, dx, dy, movement_type, false))) {
+			jump_point = pos;
+			return true;
+		}
+	}
+}
+
+/**
+ * Same as jump(), but reads the answer from the JPS+ table
+ */
+bool MapCollision::jumpPrecomputed(const pdcpp::Point<int>& pos, int dx, int dy, const pdcpp::Point<int>& end, pdcpp::Point<int>& jump_point) const {
+	const int dist = getJumpDistance(pos.x, pos.y, jumpDirIndex(dx, dy));
+	const int reach = dist > 0 ? dist : -dist;
+	const int to_end_x = end.x - pos.x;
+	const int to_end_y = end.y - pos.y;
+
+	if (dx != 0 && dy != 0) {
+		// the end is somewhere in this quadrant: stop on the diagonal where we share a row or column with it
+		if (sgn(static_cast<float>(to_end_x)) == dx && sgn(static_cast<float>(to_end_y)) == dy) {
+			const int steps = std::min(std::abs(to_end_x), std::abs(to_end_y));
+			if (steps <= reach) {
+				jump_point = pdcpp::Point<int>(pos.x + dx * steps, pos.y + dy * steps);
+				return true;
+			}
+		}
+	}
+	else {
+		// the end lies on this line before the next wall or jump point
+		const int along = dx != 0 ? to_end_x * dx : to_end_y * dy;
+		const int across = dx != 0 ? to_end_y : to_end_x;
+		if (across == 0 && along > 0 && along <= reach) {
+			jump_point = end;
+			return true;
+		}
+	}
+
+	if (dist <= 0)
+		return false;
+
+	jump_point = pdcpp::Point<int>(pos.x + dx * dist, pos.y + dy * dist);
+	return true;
+}
+
+int MapCollision::getJumpSuccessors(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent, const pdcpp::Point<int>& end, int movement_type, bool precomputed, AStarNeighbours& res) const {
+	AStarNeighbours dirs;
+	const int dir_count = getJumpDirections(pos, parent, movement_type, precomputed, dirs);
+
+	int count = 0;
+	for (int i = 0; i < dir_count; ++i) {
+		pdcpp::Point<int> jump_point(0, 0);
+		const bool found = precomputed
+			? jumpPrecomputed(pos, dirs[i].x, dirs[i].y, end, jump_point)
+			: jump(pos, dirs[i].x, dirs[i].y, end, movement_type, jump_point);
+		if (found)
+			res[count++] = jump_point;
+	}
+	return count;
+}
+
+/**
+ * Add the tiles from current (included) towards parent (excluded) to the path and move current to parent.
+ * A* parents are adjacent, but jump points are joined by straight or diagonal runs that need filling in.
+ */
+void MapCollision::pushPathSegment(std::vector<pdcpp::Point<int>>& path, pdcpp::Point<int>& current, const pdcpp::Point<int>& parent) {
+	const int dx = sgn(static_cast<float>(parent.x - current.x));
+	const int dy = sgn(static_cast<float>(parent.y - current.y));
+	while (!(current == parent)) {
+		path.push_back(collisionToMap(current));
+		current.x += dx;
+		current.y += dy;
+	}
+}
+
+/**
+* Put the start node in the open list of a search set up by beginPath
+*/
+template <class OpenList>
+void MapCollision::seedSearch(OpenList& open) {
+	AStarNode* node = astar_nodes.Get(search.start);
+	node->reset(search.start);
+	node->setActualCost(0);
+	node->setEstimatedCost(PathCosts::OctileDistance(search.start, search.end));
+	node->setParent(search.current);
 
 	open.Add(node);
+}
+
+/**
+* Expand up to `expansions` nodes of the search set up by beginPath.
+* limit is the maximum number of explored node
+* path_mode picks A*, JPS or JPS+. Every mode returns one waypoint per tile
+* @return SEARCH_DONE once the end is reached or the search is exhausted
+*/
+template <class OpenList>
+int MapCollision::searchPath(OpenList& open, unsigned int expansions) {
+	const pdcpp::Point<int>& end = search.end;
+	const unsigned int limit = search.limit;
+	pdcpp::Point<int>& current = search.current;
+	AStarNeighbours neighbours;
+
+	for (; expansions > 0; --expansions) {
+		if (open.IsEmpty() || static_cast<unsigned>(astar_close.GetSize()) >= limit)
+			return SEARCH_DONE;
 
-	while (!open.IsEmpty() && static_cast<unsigned>(close.GetSize()) < limit) {
-		node = open.GetShortestF();
+		AStarNode* node = open.GetShortestF();
 
 		current.x = node->getX();
 		current.y = node->getY();
-		close.Add(node);
+		astar_close.Add(node);
 		open.Remove(node);
+		path_stats.expanded_nodes++;
 
-		if ( current.x == end.x && current.y == end.y)
-			break; //path found !
+		if ( current.x == end.x && current.y == end.y) {
+			search.found = true;
+			return SEARCH_DONE; //path found !
+		}
 
 		//limit evaluated nodes to the size of the map
-		std::list<pdcpp::Point<int>> neighbours = node->getNeighbours(map_size.x, map_size.y);
+		const int neighbour_count = (search.path_mode == PATH_ASTAR)
+			? node->getNeighbours(neighbours, map_size.x, map_size.y)
+			: getJumpSuccessors(current, node->getParent(), end, search.movement_type, search.path_mode == PATH_JPS_PLUS, neighbours);
 
 		// for every neighbour of current node
-		for (std::list<pdcpp::Point<int>>::iterator it=neighbours.begin(); it != neighbours.end(); ++it)	{
-            pdcpp::Point<int> neighbour = *it;
+		for (int n = 0; n < neighbour_count; ++n) {
+            const pdcpp::Point<int>& neighbour = neighbours[n];
 
 			// do not exceed the node limit when adding nodes
 			if (static_cast<unsigned>(open.GetSize()) >= limit) {
 				break;
 			}
 
-			// if neighbour is not free of any collision, skip it
-			if (!isValidTile(neighbour.x,neighbour.y,movement_type, MapCollision::ENTITY_COLLIDE_ALL))
+			// if neighbour is not free of any collision, skip it (jump points are already checked)
+			if (search.path_mode == PATH_ASTAR && !isValidTile(neighbour.x,neighbour.y,search.movement_type, MapCollision::ENTITY_COLLIDE_ALL))
 				continue;
 			// if nabour is already in close, skip it
-			if(close.Exists(neighbour))
+			if(astar_close.Exists(neighbour))
 				continue;
 
 			// if neighbour isn't inside open, add it as a new Node
 			if(!open.exists(neighbour)) {
-				AStarNode* newNode = new AStarNode(neighbour);
-                newNode->setActualCost(node->getActualCost() + current.distance(neighbour));
+				AStarNode* newNode = astar_nodes.Get(neighbour);
+				newNode->reset(neighbour);
+                newNode->setActualCost(node->getActualCost() + PathCosts::OctileDistance(current, neighbour));
 				newNode->setParent(current);
-                newNode->setEstimatedCost(neighbour.distance(end));
+                newNode->setEstimatedCost(PathCosts::OctileDistance(neighbour, end));
 				open.Add(newNode);
 			}
 			// else, update it's cost if better
 			else
             {
 				AStarNode* i = open.Get(neighbour.x, neighbour.y);
-                if (node->getActualCost() + current.distance(neighbour) < i->getActualCost())
+                if (node->getActualCost() + PathCosts::OctileDistance(current, neighbour) < i->getActualCost())
                 {
                     pdcpp::Point<int> pos(i->getX(), i->getY());
                     pdcpp::Point<int> parent_pos(node->getX(), node->getY());
-                    open.UpdateParent(pos, parent_pos, node->getActualCost() + current.distance(neighbour));
+                    open.UpdateParent(pos, parent_pos, node->getActualCost() + PathCosts::OctileDistance(current, neighbour));
                 }
             }
 		}
 	}
+	return SEARCH_RUNNING;
+}
+
+/**
+* Compute a path from (x1,y1) to (x2,y2)
+* Store waypoint inside path
+* @return true if a path is found
+*/
+bool MapCollision::ComputePath(const pdcpp::Point<int>& start_pos, const pdcpp::Point<int>& end_pos, std::vector<pdcpp::Point<int>> &path, int movement_type, unsigned int limit, int path_mode) {
+	const unsigned int ticket = beginPath(start_pos, end_pos, movement_type, limit, path_mode);
+	continuePath(ticket, UINT_MAX);
+	return finishPath(ticket, path);
+}
+
+unsigned int MapCollision::beginPath(const pdcpp::Point<int>& start_pos, const pdcpp::Point<int>& end_pos, int movement_type, unsigned int limit, int path_mode) {
+	search = SearchState();
+	if (++search_tickets == 0)
+		++search_tickets;
+	search.ticket = search_tickets;
+	search.status = SEARCH_DONE;
 
-	if (!(current.x == end.x && current.y == end.y)) {
+	if (isOutsideMap(end_pos.x, end_pos.y)) return search.ticket;
+	if (isOutsideMap(start_pos.x, start_pos.y)) return search.ticket;
 
+	// default limit set to 10% of the total map size
+	if (limit == 0)
+		limit = (map_size.x * map_size.y) / 10;
+
+	// the JPS+ table only knows about normal walkers
+	if (path_mode == PATH_JPS_PLUS && (movement_type != MOVE_NORMAL || jump_distances.empty()))
+		path_mode = PATH_JPS;
+
+	// a target in another region would only exhaust the node limit
+	if (movement_type == MOVE_NORMAL && !isSameRegion(start_pos, end_pos))
+		return search.ticket;
+
+	path_stats.queries++;
+	prepareSearch(limit);
+
+	// convert start & end to MapCollision precision
+	search.start = start_pos;
+	search.end = end_pos;
+	search.current = start_pos;
+	search.movement_type = movement_type;
+	search.path_mode = path_mode;
+	search.open_list = open_list;
+	search.limit = limit;
+	search.searched = true;
+	search.status = SEARCH_RUNNING;
+
+	if (search.open_list == OPEN_LIST_BUCKETS)
+		seedSearch(astar_buckets);
+	else
+		seedSearch(astar_open);
+	return search.ticket;
+}
+
+int MapCollision::continuePath(unsigned int ticket, unsigned int expansions) {
+	if (ticket != search.ticket)
+		return SEARCH_LOST;
+	if (search.status != SEARCH_RUNNING)
+		return search.status;
+
+	if (search.open_list == OPEN_LIST_BUCKETS) {
+		const size_t bucket_capacity = astar_buckets.GetBucketCapacity();
+		search.status = searchPath(astar_buckets, expansions);
+		if (astar_buckets.GetBucketCapacity() != bucket_capacity)
+			path_stats.allocations++;
+	}
+	else {
+		search.status = searchPath(astar_open, expansions);
+	}
+	return search.status;
+}
+
+bool MapCollision::finishPath(unsigned int ticket, std::vector<pdcpp::Point<int>> &path) {
+	// path must be empty
+	if (!path.empty())
+		path.clear();
+
+	if (ticket != search.ticket || search.status != SEARCH_DONE || !search.searched)
+		return false;
+
+	const size_t path_capacity = path.capacity();
+	const pdcpp::Point<int>& start = search.start;
+	pdcpp::Point<int> current = search.current;
+
+	if (!search.found) {
 		//couldnt find the target so map a path to the closest node found
-		node = close.GetShortestH();
+		AStarNode* node = astar_close.GetShortestH();
 		current.x = node->getX();
 		current.y = node->getY();
 
 		while (!(current.x == start.x && current.y == start.y)) {
-			path.push_back(collisionToMap(current));
-			current = close.Get(current.x, current.y)->getParent();
+			pushPathSegment(path, current, astar_close.Get(current.x, current.y)->getParent());
 		}
 	}
 	else {
 		// store path from end to start
-		path.push_back(collisionToMap(end));
+		path.push_back(collisionToMap(search.end));
 		while (!(current.x == start.x && current.y == start.y)) {
-			path.push_back(collisionToMap(current));
-			current = close.Get(current.x, current.y)->getParent();
+			pushPathSegment(path, current, astar_close.Get(current.x, current.y)->getParent());
 		}
 	}
-	// reblock target if needed
-	if (target_blocks) block(end_pos.x, end_pos.y, target_blocks_type == BLOCKS_ENEMIES);
+	if (path.capacity() != path_capacity)
+		path_stats.allocations++;
 
 	return !path.empty();
 }
 
+/**
+ * Keep only the waypoints where the path has to turn. Walking from an anchor, the last waypoint
+ * still in line of movement becomes the next anchor. The path keeps ComputePath's order
+ * (end first) and is compacted in place, so no memory is allocated.
+ */
+void MapCollision::smoothPath(const pdcpp::Point<int>& start, std::vector<pdcpp::Point<int>> &path, int movement_type) {
+	if (path.size() < 2)
+		return;
+
+	std::reverse(path.begin(), path.end());
+
+	pdcpp::Point<int> anchor = start;
+	size_t kept = 0;
+	for (size_t i = 0; i + 1 < path.size(); ++i) {
+		const pdcpp::Point<int>& next = path[i + 1];
+		// from tile center to tile center, a line between corners grazes the tiles beside it
+		if (!lineOfMovement(float(anchor.x) + 0.5f, float(anchor.y) + 0.5f, float(next.x) + 0.5f, float(next.y) + 0.5f, movement_type)) {
+			anchor = path[i];
+			path[kept++] = anchor;
+		}
+	}
+	path[kept++] = path.back();
+	path.resize(kept);
+
+	std::reverse(path.begin(), path.end());
+}
+
 void MapCollision::block(const float& map_x, const float& map_y, bool is_ally) {
 	const int tile_x = int(map_x);
 	const int tile_y = int(map_y);
@@ -501,26 +990,29 @@ void MapCollision::block(const float& map_x, const float& map_y, bool is_ally) {
 	if (isTileOutsideMap(tile_x, tile_y))
 		return;
 
-	if (colmap[tile_x][tile_y] == BLOCKS_NONE) {
-		if(is_ally)
-			colmap[tile_x][tile_y] = BLOCKS_ENEMIES;
-		else
-			colmap[tile_x][tile_y] = BLOCKS_ENTITIES;
-	}
-
+	// a tile never holds anywhere near 255 entities, so the counts don't need a guard
+	const size_t index = tileIndex(tile_x, tile_y);
+	if (is_ally)
+		ally_occupancy[index]++;
+	if (occupancy[index]++ == 0)
+		logTileChange(tile_x, tile_y);
 }
 
-void MapCollision::unblock(const float& map_x, const float& map_y) {
+void MapCollision::unblock(const float& map_x, const float& map_y, bool is_ally) {
 	const int tile_x = int(map_x);
 	const int tile_y = int(map_y);
 
 	if (isTileOutsideMap(tile_x, tile_y))
 		return;
 
-	if (colmap[tile_x][tile_y] == BLOCKS_ENTITIES || colmap[tile_x][tile_y] == BLOCKS_ENEMIES) {
-		colmap[tile_x][tile_y] = BLOCKS_NONE;
-	}
+	const size_t index = tileIndex(tile_x, tile_y);
+	if (occupancy[index] == 0)
+		return;
 
+	if (is_ally && ally_occupancy[index] > 0)
+		ally_occupancy[index]--;
+	if (--occupancy[index] == 0)
+		logTileChange(tile_x, tile_y);
 }
 
 /**
@@ -556,8 +1048,34 @@ pdcpp::Point<int> MapCollision::collisionToMap(const pdcpp::Point<int>& p) {
 
 bool MapCollision::IsTileBlockedByChar(int x, int y)
 {
-	auto blockType = colmap[x][y];
-	return blockType == BLOCKS_ENEMIES;
+	if (isTileOutsideMap(x, y)) return false;
+	return ally_occupancy[tileIndex(x, y)] != 0;
+}
+
+bool MapCollision::isTileOccupied(int x, int y) const {
+	if (isTileOutsideMap(x, y)) return false;
+	return occupancy[tileIndex(x, y)] != 0;
+}
+
+unsigned char MapCollision::getAllyOccupancy(int x, int y) const {
+	if (isTileOutsideMap(x, y)) return 0;
+	return ally_occupancy[tileIndex(x, y)];
+}
+
+void MapCollision::logTileChange(int x, int y) {
+	tile_changes[tile_change_count % TILE_CHANGE_LOG_SIZE] = pdcpp::Point<int>(x, y);
+	tile_change_count++;
+}
+
+/**
+ * Read a logged tile change
+ * @return false if the change hasn't happened yet or was already overwritten
+ */
+bool MapCollision::getTileChange(unsigned int sequence, pdcpp::Point<int>& tile) const {
+	const unsigned int age = tile_change_count - sequence;
+	if (age == 0 || age > TILE_CHANGE_LOG_SIZE) return false;
+	tile = tile_changes[sequence % TILE_CHANGE_LOG_SIZE];
+	return true;
 }
 
 MapCollision::~MapCollision() {
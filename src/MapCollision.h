@@ -26,9 +26,11 @@ FLARE.  If not, see http://www.gnu.org/licenses/
 #ifndef MAP_COLLISION_H
 #define MAP_COLLISION_H
 
+#include "AStarContainer.h"
 #include "pdcpp/graphics/ImageTable.h"
 
-typedef std::vector< std::vector<unsigned short>> Map_Layer;
+// collision tiles in row-major order, index (y * width + x), like Area's layers
+typedef std::vector<unsigned char> Map_Layer;
 
 class MapCollision {
 private:
@@ -52,12 +54,73 @@ private:
 		float &x, float &y, float step_x, float step_y, int movement_type, int collide_type);
 
 	bool isValidTile(const int& x, const int& y, int movement_type, int collide_type) const;
+	size_t tileIndex(int x, int y) const { return static_cast<size_t>(y) * map_size.x + x; }
 
     pdcpp::Point<int> collisionToMap(const pdcpp::Point<int>& p);
+	void pushPathSegment(std::vector<pdcpp::Point<int>>& path, pdcpp::Point<int>& current, const pdcpp::Point<int>& parent);
 
 	bool has_empty_tile;
 
+	// search workspace reused by every ComputePath call, sized lazily to the map on the first query
+	AStarNodePool astar_nodes;
+	AStarContainer astar_open;
+	AStarCloseContainer astar_close;
+	AStarBucketContainer astar_buckets;
+	int open_list;
+
+	void prepareSearch(unsigned int limit);
+	template <class OpenList>
+	void seedSearch(OpenList& open);
+	// the search loop, shared by both open list types. Expands at most `expansions` nodes, returns SEARCH_RUNNING or SEARCH_DONE
+	template <class OpenList>
+	int searchPath(OpenList& open, unsigned int expansions);
+
+	// the search in progress, so a query can run a slice of expansions at a time
+	struct SearchState {
+		unsigned int ticket = 0;
+		pdcpp::Point<int> start = {0, 0};
+		pdcpp::Point<int> end = {0, 0};
+		pdcpp::Point<int> current = {0, 0}; // last node expanded
+		int movement_type = 0;
+		int path_mode = 0;
+		int open_list = 0; // the open list the search was seeded in
+		unsigned int limit = 0;
+		int status = 0;
+		bool searched = false; // false if the query was answered without searching
+		bool found = false;
+	};
+	SearchState search;
+	unsigned int search_tickets;
+
+	// JPS+ jump distances, jump_dir_count entries per tile, rebuilt by SetMap from the static layer.
+	// > 0 is the distance to the next jump point in that direction, <= 0 is minus the distance to a wall.
+	std::vector<short> jump_distances;
+
+	void buildJumpDistances();
+
+	// connected region of every tile for normal walkers, rebuilt by SetMap from the static layer.
+	// Diagonal neighbours only connect when both tiles beside the step are walkable (no corner cutting).
+	// Row-major like jump_distances, NO_REGION for tiles they can never stand on.
+	std::vector<unsigned short> region_labels;
+	unsigned short region_count;
+
+	void buildRegions();
+	short getJumpDistance(int x, int y, int dir) const;
+	bool isJumpWalkable(int x, int y, int movement_type, bool static_only) const;
+	bool isForcedJump(int x, int y, int dx, int dy, int movement_type, bool static_only) const;
+	int getJumpDirections(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent, int movement_type, bool static_only, AStarNeighbours& dirs) const;
+	bool jump(pdcpp::Point<int> pos, int dx, int dy, const pdcpp::Point<int>& end, int movement_type, pdcpp::Point<int>& jump_point) const;
+	bool jumpPrecomputed(const pdcpp::Point<int>& pos, int dx, int dy, const pdcpp::Point<int>& end, pdcpp::Point<int>& jump_point) const;
+	int getJumpSuccessors(const pdcpp::Point<int>& pos, const pdcpp::Point<int>& parent, const pdcpp::Point<int>& end, int movement_type, bool precomputed, AStarNeighbours& res) const;
+
 public:
+	// pathfinding counters, used to verify that queries stop allocating once the workspace is warm
+	struct PathStats {
+		unsigned int queries = 0;
+		unsigned int expanded_nodes = 0;
+		unsigned int allocations = 0; // workspace growth plus growth of the caller's path vector
+	};
+
 	// const flags
 	static const bool IS_ALLY = true;
 	static const int DEFAULT_PATH_LIMIT = 0;
@@ -69,6 +132,19 @@ public:
 		ENTITY_COLLIDE_NONE = 2
 	};
 
+	// path search algorithms, selectable per ComputePath query
+	enum {
+		PATH_ASTAR = 0,
+		PATH_JPS = 1, // jump point search, skips over open stretches instead of expanding every tile
+		PATH_JPS_PLUS = 2 // JPS using the jump distances precomputed by SetMap. Only looks at the static layer
+	};
+
+	// open list used by ComputePath
+	enum {
+		OPEN_LIST_HEAP = 0, // binary heap
+		OPEN_LIST_BUCKETS = 1 // one bucket per integer f value
+	};
+
 	// movement options
 	enum {
 		MOVE_NORMAL = 0,
@@ -89,6 +165,7 @@ public:
 		MAP_ONLY_ALT = 6,
 		BLOCKS_ENTITIES = 7, // hero or enemies are blocking this tile, so any other entity is blocked
 		BLOCKS_ENEMIES = 8  // an ally is standing on that tile, so the hero could pass if ENABLE_ALLY_COLLISION is false
+		// 7 and 8 are never stored: entities live in the occupancy layer, see block()
 	};
 
 	MapCollision();
@@ -107,10 +184,25 @@ public:
 
 	bool isFacing(const float& x1, const float& y1, char direction, const float& x2, const float& y2);
 
-	bool ComputePath(const pdcpp::Point<int>& start, const pdcpp::Point<int>& end, std::vector<pdcpp::Point<int>> &path, int movement_type, unsigned int limit);
+	bool ComputePath(const pdcpp::Point<int>& start, const pdcpp::Point<int>& end, std::vector<pdcpp::Point<int>> &path, int movement_type, unsigned int limit, int path_mode = PATH_ASTAR);
 
+	// resumable ComputePath: beginPath sets the query up, continuePath runs a slice of expansions and
+	// finishPath writes the result. There's one search per collider, so a new beginPath (or ComputePath)
+	// abandons the one in progress and its ticket gets SEARCH_LOST.
+	enum {
+		SEARCH_RUNNING = 0,
+		SEARCH_DONE = 1,
+		SEARCH_LOST = 2
+	};
+	unsigned int beginPath(const pdcpp::Point<int>& start, const pdcpp::Point<int>& end, int movement_type, unsigned int limit, int path_mode = PATH_ASTAR);
+	int continuePath(unsigned int ticket, unsigned int expansions);
+	bool finishPath(unsigned int ticket, std::vector<pdcpp::Point<int>> &path);
+	// string pulling: drops the waypoints of a ComputePath result that can be skipped by moving in a straight line
+	void smoothPath(const pdcpp::Point<int>& start, std::vector<pdcpp::Point<int>> &path, int movement_type);
+
+	// entities are counted per tile, so every block needs a matching unblock with the same is_ally
 	void block(const float& map_x, const float& map_y, bool is_ally);
-	void unblock(const float& map_x, const float& map_y);
+	void unblock(const float& map_x, const float& map_y, bool is_ally);
 
     pdcpp::Point<int> getRandomNeighbor(const pdcpp::Point<int>& target, int range, int movement_type, int collide_type);
 
@@ -119,10 +211,47 @@ public:
 	}
 
 	bool hasEmptyTile() { return has_empty_tile; }
+	bool isStaticWalkable(int x, int y) const;
+	// bumped whenever the static (terrain) layer changes, so cached data derived from it can be invalidated
+	unsigned int getStaticVersion() const { return static_version; }
+	void setOpenList(int type) { open_list = type; }
+	int getOpenList() const { return open_list; }
+	const PathStats& getPathStats() const { return path_stats; }
+	void resetPathStats() { path_stats = PathStats(); }
 	bool IsTileBlockedByChar(int x, int y);
+	bool isTileOccupied(int x, int y) const;
+	// how many allies are counted on the tile, so an ally can tell itself apart from the others
+	unsigned char getAllyOccupancy(int x, int y) const;
+
+	// Region labels let unreachable queries fail without searching. Only the static layer is
+	// labelled, entities never split a region.
+	static const unsigned short NO_REGION = 0;
+	unsigned short getRegion(int x, int y) const;
+	unsigned short getRegionCount() const { return region_count; }
+	bool isSameRegion(const pdcpp::Point<int>& from, const pdcpp::Point<int>& to) const;
+
+	// Every block/unblock that changes a tile is logged so incremental planners can catch up.
+	// The log is a ring: readers that fall more than TILE_CHANGE_LOG_SIZE changes behind have to resync.
+	static const unsigned int TILE_CHANGE_LOG_SIZE = 512;
+	unsigned int getTileChangeCount() const { return tile_change_count; }
+	bool getTileChange(unsigned int sequence, pdcpp::Point<int>& tile) const;
 
-	Map_Layer colmap;
     pdcpp::Point<int> map_size;
+
+private:
+	// Static layer: terrain only (BLOCKS_NONE to MAP_ONLY_ALT), one byte per tile, row-major.
+	// Dynamic layer: how many entities stand on each tile, and how many of them are allies.
+	// Keeping them apart means blocking a tile never loses the terrain underneath.
+	Map_Layer static_tiles;
+	std::vector<unsigned char> occupancy;
+	std::vector<unsigned char> ally_occupancy;
+
+	PathStats path_stats;
+	unsigned int static_version;
+	std::vector<pdcpp::Point<int>> tile_changes;
+	unsigned int tile_change_count;
+
+	void logTileChange(int x, int y);
 };
 
 #endif
@@ -2,15 +2,25 @@
 #define MAP_GENERATION_TYPES_H
 
 #include "Globals.h"
+#include <vector>
 
 /**
  * @file MapGenerationTypes.h
  * @brief Shared types for procedural map generation.
  *
- * This file defines the base configuration struct used by both
+ * This file defines the tile layers and the base configuration struct used by both
  * Area (incremental generation) and ProceduralMapGenerator (blocking generation).
  */
 
+struct Tile {
+    int id;
+    bool collision;
+};
+
+struct Layer {
+    std::vector<Tile> tiles;
+};
+
 /**
  * @struct MapGenerationParams
  * @brief Base parameters for procedural map generation.
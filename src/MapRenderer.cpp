@@ -0,0 +1,144 @@
+#include "MapRenderer.h"
+#include "Globals.h"
+#include "Log.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/graphics/Colors.h"
+#include "pdcpp/graphics/Graphics.h"
+#include <algorithm>
+
+MapRenderer::~MapRenderer()
+{
+    Invalidate();
+}
+
+void MapRenderer::Reset(const int _width, const int _height, const int _tileWidth, const int _tileHeight)
+{
+    Invalidate();
+    if (_width <= 0 || _height <= 0) return;
+
+    width = _width;
+    height = _height;
+    tileWidth = _tileWidth;
+    tileHeight = _tileHeight;
+    chunksX = (width + Globals::MAP_RENDER_CHUNK_TILES - 1) / Globals::MAP_RENDER_CHUNK_TILES;
+    chunksY = (height + Globals::MAP_RENDER_CHUNK_TILES - 1) / Globals::MAP_RENDER_CHUNK_TILES;
+    chunks.resize(chunksX * chunksY);
+}
+
+void MapRenderer::Invalidate()
+{
+    auto* graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    for (Chunk& chunk : chunks)
+    {
+        if (chunk.bitmap) graphics->freeBitmap(chunk.bitmap);
+    }
+    chunks.clear();
+    chunksX = 0;
+    chunksY = 0;
+}
+
+void MapRenderer::MarkTileDirty(const int x, const int y)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height || chunks.empty()) return;
+    chunks[(y / Globals::MAP_RENDER_CHUNK_TILES) * chunksX + (x / Globals::MAP_RENDER_CHUNK_TILES)].dirty = true;
+}
+
+void MapRenderer::Draw(const Layer& layer, const pdcpp::Rectangle<int>& visibleTiles, RenderStats& stats)
+{
+    if (visibleTiles.width <= 0 || visibleTiles.height <= 0) return;
+    auto* graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+
+    const int firstChunkX = visibleTiles.x / Globals::MAP_RENDER_CHUNK_TILES;
+    const int firstChunkY = visibleTiles.y / Globals::MAP_RENDER_CHUNK_TILES;
+    const int lastChunkX = std::min(chunksX - 1, (visibleTiles.getRight() - 1) / Globals::MAP_RENDER_CHUNK_TILES);
+    const int lastChunkY = std::min(chunksY - 1, (visibleTiles.getBottom() - 1) / Globals::MAP_RENDER_CHUNK_TILES);
+
+    for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY)
+    {
+        for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX)
+        {
+            Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+            const pdcpp::Rectangle<int> chunkTiles = GetChunkTiles(chunkX, chunkY);
+            if (chunk.dirty && Rasterise(chunk, layer, chunkTiles))
+            {
+                stats.chunksRasterised++;
+            }
+
+            if (chunk.bitmap)
+            {
+                graphics->drawBitmap(chunk.bitmap, chunkTiles.x * tileWidth, chunkTiles.y * tileHeight, kBitmapUnflipped);
+                stats.mapDrawCalls++;
+                stats.chunksDrawn++;
+                continue;
+            }
+
+            // No bitmap for this chunk, draw the visible part of it tile by tile
+            const int firstX = std::max(chunkTiles.x, visibleTiles.x);
+            const int firstY = std::max(chunkTiles.y, visibleTiles.y);
+            const int lastX = std::min(chunkTiles.getRight(), visibleTiles.getRight());
+            const int lastY = std::min(chunkTiles.getBottom(), visibleTiles.getBottom());
+            stats.mapDrawCalls += DrawTiles(layer, width, {firstX, firstY, lastX - firstX, lastY - firstY}, tileWidth, tileHeight);
+        }
+    }
+}
+
+int MapRenderer::DrawTile(const Tile& tile, const pdcpp::Rectangle<int>& tileRect)
+{
+    if (tile.collision) {
+        // Obstacle tiles - draw dark rectangles with white border
+        pdcpp::Graphics::fillRectangle(tileRect, pdcpp::Colors::black);
+        // Draw border for obstacles to make them stand out
+        pdcpp::Graphics::drawRectangle(tileRect, pdcpp::Colors::white);
+        return 2;
+    }
+    // Walkable tiles - draw light gray ground
+    pdcpp::Graphics::fillRectangle(tileRect, pdcpp::Colors::solid50GrayA);
+    return 1;
+}
+
+int MapRenderer::DrawTiles(const Layer& layer, const int width, const pdcpp::Rectangle<int>& tiles, const int tileWidth, const int tileHeight)
+{
+    int drawCalls = 0;
+    // Row-major, the same order as Layer::tiles
+    for (int y = tiles.y; y < tiles.getBottom(); ++y)
+    {
+        for (int x = tiles.x; x < tiles.getRight(); ++x)
+        {
+            drawCalls += DrawTile(layer.tiles[(y * width) + x], {x * tileWidth, y * tileHeight, tileWidth, tileHeight});
+        }
+    }
+    return drawCalls;
+}
+
+pdcpp::Rectangle<int> MapRenderer::GetChunkTiles(const int chunkX, const int chunkY) const
+{
+    const int x = chunkX * Globals::MAP_RENDER_CHUNK_TILES;
+    const int y = chunkY * Globals::MAP_RENDER_CHUNK_TILES;
+    return {x, y, std::min(Globals::MAP_RENDER_CHUNK_TILES, width - x), std::min(Globals::MAP_RENDER_CHUNK_TILES, height - y)};
+}
+
+bool MapRenderer::Rasterise(Chunk& chunk, const Layer& layer, const pdcpp::Rectangle<int>& chunkTiles)
+{
+    chunk.dirty = false;
+    if (!chunk.bitmap)
+    {
+        chunk.bitmap = pdcpp::GlobalPlaydateAPI::get()->graphics->newBitmap(chunkTiles.width * tileWidth, chunkTiles.height * tileHeight, kColorBlack);
+        if (!chunk.bitmap)
+        {
+            Log::Error("MapRenderer: couldn't allocate the bitmap of chunk %d,%d, drawing its tiles every frame", chunkTiles.x, chunkTiles.y);
+            return false;
+        }
+    }
+
+    // Tiles are drawn relative to the chunk. Chunks are a multiple of 8 pixels wide, so the gray pattern lines up across them.
+    pdcpp::Graphics::ScopedGraphicsContext context(chunk.bitmap);
+    for (int y = chunkTiles.y; y < chunkTiles.getBottom(); ++y)
+    {
+        for (int x = chunkTiles.x; x < chunkTiles.getRight(); ++x)
+        {
+            const pdcpp::Rectangle<int> tileRect((x - chunkTiles.x) * tileWidth, (y - chunkTiles.y) * tileHeight, tileWidth, tileHeight);
+            DrawTile(layer.tiles[(y * width) + x], tileRect);
+        }
+    }
+    return true;
+}
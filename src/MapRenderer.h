@@ -0,0 +1,79 @@
+#ifndef CARDOBLAST_MAPRENDERER_H
+#define CARDOBLAST_MAPRENDERER_H
+
+#include "MapGenerationTypes.h"
+#include "pd_api.h"
+#include "pdcpp/graphics/Rectangle.h"
+#include <vector>
+
+/**
+ * @brief Counters of the last Area::SubmitDraw and Area::RenderMap.
+ */
+struct RenderStats
+{
+    int mapDrawCalls = 0;     ///< Graphics calls spent on the map this frame
+    int tilesVisited = 0;     ///< Tiles inside the visible range this frame
+    int chunksDrawn = 0;      ///< Chunk bitmaps drawn this frame
+    int chunksRasterised = 0; ///< Dirty chunks redrawn into their bitmap this frame
+    int monstersDrawn = 0;    ///< Monsters that passed culling
+    int timeUs = 0;           ///< Time spent culling and drawing the map (microseconds)
+};
+
+/**
+ * @brief Draws the static tile layer of a map from cached chunk bitmaps.
+ *
+ * The map is cut in chunks of Globals::MAP_RENDER_CHUNK_TILES square tiles. A chunk is
+ * rasterised into its own off-screen bitmap the first time it's visible, and then drawn
+ * with a single bitmap draw per frame until one of its tiles changes and MarkTileDirty
+ * flags it. Chunks never seen are never allocated, so memory follows the explored area
+ * rather than the map size.
+ * Bitmaps land in world coordinates, so the draw offset of the camera places them.
+ * A chunk whose bitmap can't be allocated draws its visible tiles directly instead.
+ */
+class MapRenderer
+{
+public:
+    MapRenderer() = default;
+    ~MapRenderer();
+    MapRenderer(const MapRenderer&) = delete;
+    MapRenderer& operator=(const MapRenderer&) = delete;
+
+    // Size the chunk grid for a new map. Every chunk starts dirty.
+    void Reset(int width, int height, int tileWidth, int tileHeight);
+    // Free every chunk bitmap
+    void Invalidate();
+    void MarkTileDirty(int x, int y);
+    [[nodiscard]] bool IsReady() const { return !chunks.empty(); }
+
+    /**
+     * @brief Draw the chunks overlapping `visibleTiles`, rasterising the dirty ones first.
+     * @param visibleTiles range of tiles to draw, in tiles, already clamped to the map
+     */
+    void Draw(const Layer& layer, const pdcpp::Rectangle<int>& visibleTiles, RenderStats& stats);
+
+    // Draws one tile into the current context. Returns the graphics calls spent.
+    static int DrawTile(const Tile& tile, const pdcpp::Rectangle<int>& tileRect);
+    // Draws the tiles of `tiles`, row by row. Returns the graphics calls spent.
+    static int DrawTiles(const Layer& layer, int width, const pdcpp::Rectangle<int>& tiles, int tileWidth, int tileHeight);
+
+private:
+    struct Chunk
+    {
+        LCDBitmap* bitmap = nullptr;
+        bool dirty = true;
+    };
+
+    // Tiles of the chunk, clamped to the map
+    [[nodiscard]] pdcpp::Rectangle<int> GetChunkTiles(int chunkX, int chunkY) const;
+    bool Rasterise(Chunk& chunk, const Layer& layer, const pdcpp::Rectangle<int>& chunkTiles);
+
+    std::vector<Chunk> chunks; // row-major, chunksX * chunksY
+    int chunksX = 0;
+    int chunksY = 0;
+    int width = 0; // tiles
+    int height = 0;
+    int tileWidth = 0;
+    int tileHeight = 0;
+};
+
+#endif //CARDOBLAST_MAPRENDERER_H
@@ -6,8 +6,8 @@
 #include "Globals.h"
 #include "Player.h"
 #include "Log.h"
-#include "EnemyProjectile.h"
 #include "Area.h"
+#include "MonsterPrototypes.h"
 #include "pdcpp/core/GlobalPlaydateAPI.h"
 #include <algorithm>
 #include <cmath>
@@ -20,7 +20,7 @@ Monster::Monster(unsigned int _id, const std::string& _name, const std::string&
 {
     // Keeping weapon and armor on zeros to reduce JSON token utilization
 }
-void Monster::Tick(Player* player, Area* area)
+void Monster::Tick(Player* player, Area* area, const int slot)
 {
     if (GetHP() <= 0) return;
 
@@ -43,7 +43,7 @@ void Monster::Tick(Player* player, Area* area)
         }
         break;
     case MovementType::RangedKite:
-        HandleRangedKiteMovement(playerTiledPosition, area);
+        HandleRangedKiteMovement(playerTiledPosition, area, slot);
         // RangedKite monsters can fire ranged attacks
         if (CanRangedAttack(player))
         {
@@ -104,6 +104,7 @@ std::shared_ptr<void> Monster::DecodeJson(char *buffer, jsmntok_t *tokens, int s
                                        decodedAgility, decodedConstitution, 0, decodedXp,
                                        0, 0);
         creatures_decoded.back().SetMovementType(decodedMovement);
+        creatures_decoded.back().SetPrototypeIndex(MonsterPrototypes::Register(creatures_decoded.back()));
         Log::Info("Monster ID: %d, name %s, XP: %i", decodedId, decodedName.c_str(), decodedXp);
 
         i+=(tokens[i].size*2);
@@ -113,40 +114,25 @@ std::shared_ptr<void> Monster::DecodeJson(char *buffer, jsmntok_t *tokens, int s
 
 void Monster::HandleAStarMovement(const pdcpp::Point<int>& playerTiledPosition, Area* area)
 {
-    if (pathFindingCooldown > 0)
-    {
-        pathFindingCooldown--;
-    }
-    else if (canComputePath && !pathFound && pathFindFailureCount < Globals::MAX_PATH_FIND_FAILURE_COUNT && ShouldMove(playerTiledPosition))
-    {
-        CalculateNodesToTarget(playerTiledPosition, area);
-        pathFindingCooldown = Globals::PATH_FINDING_COOLDOWN; // Reset cooldown after pathfinding
-    }
-    if (pathFound)
+    // AStar monsters don't own a path anymore. They follow the area's shared flow field
+    // towards the player, which is rebuilt once per player tile instead of once per monster.
+    pathFound = false;
+    path.clear();
+    if (reachedNode)
     {
-        if (!path.empty())
+        if (!ShouldMove(playerTiledPosition))
         {
-            if (reachedNode)
-            {
-                nextPosition = path.back(); // Get the next position in the path
-                path.pop_back(); // Remove the previous position from the path
-                reachedNode = false;
-            }
-            Move(nextPosition, area);
+            return;
         }
-        else
-        {
-            pathFound = false; // Reset if path is empty
-        }
-    }
-    else if (pathFindFailureCount >= Globals::MAX_PATH_FIND_FAILURE_COUNT)
-    {
-        pathFindFailureCount++; // Increment failure count
-        if (pathFindFailureCount >= Globals::MAX_PATH_FIND_FAILURE_COUNT * Globals::MULT_FOR_RESET_PATH_FIND_FAILURE) // If too many failures, reset
+        pdcpp::Point<int> step = {0, 0};
+        if (!area->GetPlayerFlowField().GetNextStep(GetTiledPosition(), step, area->GetCollider()))
         {
-            pathFindFailureCount = 0; // Give the chance to try again after a long time
+            return; // Already next to the player, unreachable, or every better tile is taken
         }
+        nextPosition = step;
+        reachedNode = false;
     }
+    Move(nextPosition, area);
 }
 
 void Monster::HandleNoClipMovement(const pdcpp::Point<int>& playerTiledPosition)
@@ -160,7 +146,7 @@ void Monster::HandleNoClipMovement(const pdcpp::Point<int>& playerTiledPosition)
     MoveNoClip(playerTiledPosition);
 }
 
-void Monster::HandleRangedKiteMovement(const pdcpp::Point<int>& playerTiledPosition, Area* area)
+void Monster::HandleRangedKiteMovement(const pdcpp::Point<int>& playerTiledPosition, Area* area, const int slot)
 {
     float distance = GetTiledPosition().distance(playerTiledPosition);
     if (distance > Globals::MONSTER_AWARENESS_RADIUS)
@@ -189,21 +175,28 @@ void Monster::HandleRangedKiteMovement(const pdcpp::Point<int>& playerTiledPosit
         return;
     }
 
+    if (UsesPlanner(area->GetCollider()))
+    {
+        FollowPlanner(target, area, slot);
+        return;
+    }
+
     if (target.x != lastPathTarget.x || target.y != lastPathTarget.y)
     {
         pathFound = false;
         path.clear();
         lastPathTarget = target;
+        requestTarget = target; // a request still waiting in the scheduler goes to the new target
+        pathFindFailureCount = 0; // a new target gets its own tries
     }
 
     if (pathFindingCooldown > 0)
     {
         pathFindingCooldown--;
     }
-    else if (shouldMove && canComputePath && !pathFound && pathFindFailureCount < Globals::MAX_PATH_FIND_FAILURE_COUNT)
+    else if (shouldMove && !pathFound && pathFindFailureCount < Globals::MAX_PATH_FIND_FAILURE_COUNT)
     {
-        CalculateNodesToTarget(target, area);
-        pathFindingCooldown = Globals::PATH_FINDING_COOLDOWN;
+        RequestPath(GetTiledPosition(), target); // computed by the area on the next tick
     }
 
     if (pathFound)
@@ -225,6 +218,83 @@ void Monster::HandleRangedKiteMovement(const pdcpp::Point<int>& playerTiledPosit
     }
 }
 
+void Monster::FollowPlanner(const pdcpp::Point<int>& target, Area* area, const int slot)
+{
+    // The planner repairs its search as the target and the other monsters move,
+    // so it can be asked every step without a cooldown
+    pathFound = false;
+    path.clear();
+    if (reachedNode)
+    {
+        const DStarLite* planner = area->GetMonsterStore().FindPlanner(slot);
+        pdcpp::Point<int> step = {0, 0};
+        if (!planReady || !planner || planner->GetStart() != GetTiledPosition() || !planner->GetNextStep(step))
+        {
+            RequestPath(GetTiledPosition(), target);
+            return;
+        }
+        if (Globals::MONSTER_PATH_SMOOTHING && planner->GetPathAhead(path, Globals::DSTAR_SMOOTHING_LOOKAHEAD))
+        {
+            // Skip the steps a straight line covers, like the computed paths
+            area->GetCollider()->smoothPath(GetTiledPosition(), path, MapCollision::MOVE_NORMAL);
+            step = path.back();
+            path.clear();
+        }
+        nextPosition = step;
+        reachedNode = false;
+        // Plan from the tile we're walking to, so the next step is ready when we get there
+        RequestPath(step, target);
+    }
+    Move(nextPosition, area);
+}
+
+void Monster::RequestPath(const pdcpp::Point<int>& start, const pdcpp::Point<int>& target)
+{
+    requestStart = start;
+    requestTarget = target;
+    pathRequested = true;
+    planReady = false;
+}
+
+bool Monster::ProcessPathRequest(Area* area, const int slot, const unsigned int expansionSlice)
+{
+    if (!pathRequested) return true;
+
+    MapCollision* collider = area->GetCollider();
+    if (!collider->isSameRegion(requestStart, requestTarget))
+    {
+        // Unreachable, don't spend a search on it
+        pathRequested = false;
+        return true;
+    }
+
+    if (UsesPlanner(collider))
+    {
+        DStarLite& planner = area->GetMonsterStore().GetPlanner(slot);
+        planner.Update(collider, requestStart, requestTarget, expansionSlice);
+        if (!planner.IsSearchComplete())
+        {
+            return false;
+        }
+        planReady = true;
+    }
+    else
+    {
+        if (!CalculateNodesToTarget(requestTarget, area, expansionSlice))
+        {
+            return false;
+        }
+        pathFindingCooldown = Globals::PATH_FINDING_COOLDOWN;
+    }
+    pathRequested = false;
+    return true;
+}
+
+bool Monster::UsesPlanner(const MapCollision* collider)
+{
+    return collider->map_size.x * collider->map_size.y <= Globals::DSTAR_MAX_MAP_TILES;
+}
+
 bool Monster::ShouldMove(pdcpp::Point<int> playerPosition) const
 {
     float distance = GetTiledPosition().distance(playerPosition);
@@ -235,10 +305,24 @@ bool Monster::ShouldMove(pdcpp::Point<int> playerPosition) const
     return false;
 }
 
-void Monster::CalculateNodesToTarget(const pdcpp::Point<int> target, const Area* area)
+bool Monster::CalculateNodesToTarget(const pdcpp::Point<int> target, Area* area, const unsigned int expansionSlice)
 {
+    // Long queries go through the cluster graph, short ones end up in the collider's A*.
+    // The hierarchy runs one query at a time, so a query abandoned for another one (or for a new target) starts over.
+    HierarchicalPathfinder* hierarchy = area->GetPathHierarchy();
+    if (!hierarchy->IsQueryActive(searchTicket) || searchTarget != target)
+    {
+        searchTicket = hierarchy->BeginPath(area->GetCollider(), GetTiledPosition(), target, MapCollision::MOVE_NORMAL);
+        searchTarget = target;
+    }
+    if (!hierarchy->ContinuePath(area->GetCollider(), searchTicket, expansionSlice))
+    {
+        return false;
+    }
+
     path.clear();
-    pathFound = area->GetCollider()->ComputePath(GetTiledPosition(), target, path, MapCollision::MOVE_NORMAL, MapCollision::DEFAULT_PATH_LIMIT);
+    pathFound = hierarchy->FinishPath(searchTicket, path);
+    searchTicket = 0;
     if (!pathFound)
     {
         pathFindFailureCount++;
@@ -246,7 +330,13 @@ void Monster::CalculateNodesToTarget(const pdcpp::Point<int> target, const Area*
     else
     {
         pathFindFailureCount = 0; // Reset failure count on success
+        if (Globals::MONSTER_PATH_SMOOTHING)
+        {
+            // Move() walks straight lines, so only the turns need to be nodes
+            area->GetCollider()->smoothPath(GetTiledPosition(), path, MapCollision::MOVE_NORMAL);
+        }
     }
+    return true;
 }
 
 void Monster::Move(pdcpp::Point<int> target, Area* area)
@@ -291,31 +381,27 @@ void Monster::Move(pdcpp::Point<int> target, Area* area)
             moveSpeed = std::max(1, static_cast<int>(static_cast<float>(moveSpeed) * slowdownFactor));
         }
 
-        if (d.x != 0 && d.y != 0)
+        // Interpolate along the straight line from where this node was started. Smoothed paths
+        // have nodes several tiles apart, and stepping each axis (or re-aiming every tick)
+        // would drift off the line that was checked against the walls.
+        if (fPos != segmentTarget || iPos != segmentPosition)
         {
-            // ensure move scale is less when moving in diagonals but never less than 1
-            // La hipotenusa, que es la diagonal del cuadrado, es en realidad √2 veces la longitud de uno de sus lados.
-            // Esto equivale aproximadamente a 1.414 veces la longitud del lado, lo que representa un aumento de alrededor del 41.4%,
-            moveSpeed = std::max(1, static_cast<int>(static_cast<float>(moveSpeed) * Globals::MONSTER_DIAGONAL_MOVE_SCALE));
+            segmentOrigin = iPos;
+            segmentTarget = fPos;
+            segmentProgress = 0.0f;
         }
-        if (d.x > 0)
+        const pdcpp::Point<int> segment = {fPos.x - segmentOrigin.x, fPos.y - segmentOrigin.y};
+        const float length = std::sqrt(static_cast<float>(segment.x * segment.x + segment.y * segment.y));
+        segmentProgress += static_cast<float>(moveSpeed);
+        if (segmentProgress >= length)
         {
-            dn.x = moveSpeed;
-            if (dn.x > d.x) dn.x = d.x; // Ensure we do not overshoot the target in x direction
+            dn = d; // arrive this tick
         }
-        else if (d.x < 0)
-        {
-            dn.x = -moveSpeed; // Ensure we do not overshoot the target in x direction
-        }
-        if (d.y > 0)
-        {
-            dn.y = moveSpeed;
-            if (dn.y > d.y) dn.y = d.y; // Ensure we do not overshoot the target in y direction
-        }
-        else if (d.y < 0)
+        else
         {
-            dn.y = -moveSpeed;
-            if (dn.y < d.y) dn.y = d.y; // Ensure we do not overshoot the target in y direction
+            const float t = segmentProgress / length;
+            dn.x = segmentOrigin.x + static_cast<int>(std::lround(static_cast<float>(segment.x) * t)) - iPos.x;
+            dn.y = segmentOrigin.y + static_cast<int>(std::lround(static_cast<float>(segment.y) * t)) - iPos.y;
         }
     }
     else
@@ -325,7 +411,11 @@ void Monster::Move(pdcpp::Point<int> target, Area* area)
     }
 
     pdcpp::Point<int> newPosition {iPos.x + dn.x, iPos.y + dn.y};
-    if (area->GetCollider()->IsTileBlockedByChar(newPosition.x / Globals::MAP_TILE_SIZE, newPosition.y / Globals::MAP_TILE_SIZE))
+    const pdcpp::Point<int> newTile {newPosition.x / Globals::MAP_TILE_SIZE, newPosition.y / Globals::MAP_TILE_SIZE};
+    // The area keeps our current tile blocked while we tick, so there it only counts if someone else is on it too
+    const bool ownTile = newTile == GetTiledPosition();
+    const int others = area->GetCollider()->getAllyOccupancy(newTile.x, newTile.y) - (ownTile ? 1 : 0);
+    if (others > 0)
     {
         // This is a workaround to avoid the monster getting stuck in a tile,
         // and sharing the same position as the other monsters.
@@ -335,6 +425,7 @@ void Monster::Move(pdcpp::Point<int> target, Area* area)
         newPosition.y += static_cast<int>(random.next()% Globals::MONSTER_RANDOM_SPACING) - static_cast<int>((random.next()%Globals::MONSTER_RANDOM_SPACING));
     }
     SetPosition(newPosition);
+    segmentPosition = newPosition;
 
     // calculate the actual difference between start and after movement to validate it is not stuck
     if (iPosCache.x == newPosition.x && iPosCache.y == newPosition.y)
@@ -344,19 +435,9 @@ void Monster::Move(pdcpp::Point<int> target, Area* area)
         return;
     }
 
-    // In case the new position is close to the target, return true.
-    if (newPosition.distance(target) < 1.f)
-    {
-        reachedNode = true;
-    }
-
-    // Calculate if the new position is beyond the target position, so we mark it as reached. And move to the next node.
-    // This is good to avoid "jittering", returning when passing the node, or reducing the movement rate
-    // Check if we've passed the target position in either axis and mark node as reached
-    if ((dn.x > 0 && newPosition.x >= fPos.x) ||
-        (dn.x < 0 && newPosition.x <= fPos.x) ||
-        (dn.y > 0 && newPosition.y >= fPos.y) ||
-        (dn.y < 0 && newPosition.y <= fPos.y))
+    // Mark the node as reached once we get to it or pass it, to avoid "jittering" back to it.
+    const pdcpp::Point<int> remaining = {fPos.x - newPosition.x, fPos.y - newPosition.y};
+    if (remaining.x * d.x + remaining.y * d.y <= 0)
     {
         reachedNode = true;
     }
@@ -438,8 +519,9 @@ pdcpp::Point<int> Monster::GetKiteTarget(const pdcpp::Point<int>& playerTiledPos
                 continue; // Out of bounds, try next direction
             }
 
-            // Check if tile is walkable (not blocked by terrain or other monsters)
-            if (!area->GetCollider()->IsTileBlockedByChar(targetX, targetY))
+            // Check if tile is walkable (not blocked by terrain or other monsters) and we can actually get there
+            MapCollision* collider = area->GetCollider();
+            if (!collider->IsTileBlockedByChar(targetX, targetY) && collider->isSameRegion(monsterTiled, {targetX, targetY}))
             {
                 return {targetX, targetY}; // Found valid retreat position!
             }
@@ -25,14 +25,30 @@ public:
     Monster() = default;
     Monster(const Monster &other) = default;
     Monster(Monster &&other) noexcept = default;
+    Monster& operator=(const Monster &other) = default; // keeps the buffers this instance already owns
     Monster(unsigned int _id, const std::string& _name, const std::string& _image, float _maxHp, int _strength, int _agility,
              int _constitution, float _evasion, unsigned int _xp, int weapon, int armor);
 
-    void Tick(Player* player, Area* area);
+    // `slot` is the monster's slot in the area's MonsterStore
+    void Tick(Player* player, Area* area, int slot);
     std::shared_ptr<void> DecodeJson(char *buffer, jsmntok_t *tokens, int size, EntityManager* entityManager) override;
-    void SetCanComputePath(bool value) { canComputePath = value; }
+    [[nodiscard]] bool HasPathRequest() const { return pathRequested; }
+
+    /**
+     * @brief Work on the pending path request, called by the area's PathScheduler.
+     * @param slot The monster's slot in the area's MonsterStore, which keeps its D* Lite planner
+     * @param expansionSlice Tiles the search may expand in this call
+     * @return true once the request is done, false if it needs another slice
+     */
+    bool ProcessPathRequest(Area* area, int slot, unsigned int expansionSlice);
     void SetMovementType(MovementType value) { movementType = value; }
     [[nodiscard]] MovementType GetMovementType() const { return movementType; }
+    // Entry of the MonsterPrototypes table holding the name, image path and description. -1 if not registered.
+    [[nodiscard]] int GetPrototypeIndex() const { return prototypeIndex; }
+    void SetPrototypeIndex(int value) { prototypeIndex = value; }
+    // Instance of the area's MonsterPool this monster lives in, -1 if it wasn't acquired from one
+    [[nodiscard]] int GetPoolSlot() const { return poolSlot; }
+    void SetPoolSlot(int value) { poolSlot = value; }
     
     // Ranged attack methods
     [[nodiscard]] bool CanRangedAttack(Player* player) const;
@@ -42,12 +58,16 @@ public:
 private:
     [[nodiscard]] bool ShouldMove(pdcpp::Point<int> playerPosition) const;
     [[nodiscard]] bool ShouldAttack(pdcpp::Point<int> target) const;
-    void CalculateNodesToTarget(pdcpp::Point<int> target, const Area* area);
+    // Runs a slice of the path search towards `target`. Returns true once it's done and `path` is set.
+    bool CalculateNodesToTarget(pdcpp::Point<int> target, Area* area, unsigned int expansionSlice);
     void Move(pdcpp::Point<int> target, Area* area);
     void MoveNoClip(pdcpp::Point<int> target);
     void HandleAStarMovement(const pdcpp::Point<int>& playerTiledPosition, Area* area);
     void HandleNoClipMovement(const pdcpp::Point<int>& playerTiledPosition);
-    void HandleRangedKiteMovement(const pdcpp::Point<int>& playerTiledPosition, Area* area);
+    void HandleRangedKiteMovement(const pdcpp::Point<int>& playerTiledPosition, Area* area, int slot);
+    void FollowPlanner(const pdcpp::Point<int>& target, Area* area, int slot);
+    void RequestPath(const pdcpp::Point<int>& start, const pdcpp::Point<int>& target);
+    [[nodiscard]] static bool UsesPlanner(const MapCollision* collider);
 
     /**
      * @brief Calculate intelligent retreat position for kiting behavior.
@@ -69,9 +89,20 @@ private:
     pdcpp::Point<int> lastPathTarget = {0, 0};
     pdcpp::Point<int> nextPosition = {0, 0}; // Next position to move to
     bool reachedNode = true; // Flag to check if the node was reached
+    pdcpp::Point<int> segmentOrigin = {0, 0}; // Pixel position where Move started towards the current node
+    pdcpp::Point<int> segmentTarget = {-1, -1}; // Pixel position of the current node
+    pdcpp::Point<int> segmentPosition = {-1, -1}; // Last position set by Move, anything else restarts the segment
+    float segmentProgress = 0.0f; // Pixels travelled from segmentOrigin
     int pathFindingCooldown = 0; // Cooldown for pathfinding to avoid spamming
-    bool canComputePath = true; // Flag to check if pathfinding is allowed
+    bool planReady = false; // The D* Lite planner (MonsterStore::GetPlanner) finished the last request
+    bool pathRequested = false; // Waiting for the PathScheduler
+    pdcpp::Point<int> requestStart = {0, 0};
+    pdcpp::Point<int> requestTarget = {0, 0};
+    unsigned int searchTicket = 0; // HierarchicalPathfinder query in progress, 0 if none
+    pdcpp::Point<int> searchTarget = {0, 0};
     MovementType movementType = MovementType::AStar;
+    int prototypeIndex = -1;
+    int poolSlot = -1;
     unsigned int lastAttackTime = 0; // Last time the monster attacked (for cooldown)
 };
 
@@ -0,0 +1,115 @@
+#include "MonsterBenchmark.h"
+#include "Area.h"
+#include "Globals.h"
+#include "Log.h"
+#include "MapCollision.h"
+#include "Monster.h"
+#include "Player.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/core/Random.h"
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+
+namespace
+{
+    constexpr int MAP_SIZE = Globals::DEFAULT_MAP_WIDTH;
+    constexpr int SWEEP_PASSES = 100;
+
+    constexpr Monster::MovementType MOVEMENT_TYPES[] = {
+        Monster::MovementType::AStar,
+        Monster::MovementType::NoClip,
+        Monster::MovementType::Stationary,
+        Monster::MovementType::RangedKite,
+    };
+
+    pdcpp::Point<int> RandomWalkablePixel(const MapCollision& collider, pdcpp::Random& random)
+    {
+        const int width = collider.map_size.x;
+        const int height = collider.map_size.y;
+        for (int attempt = 0; attempt < 1000; ++attempt)
+        {
+            const int x = static_cast<int>(random.next() % static_cast<unsigned int>(width));
+            const int y = static_cast<int>(random.next() % static_cast<unsigned int>(height));
+            if (collider.isStaticWalkable(x, y))
+            {
+                return {x * Globals::MAP_TILE_SIZE + Globals::MAP_TILE_SIZE / 2, y * Globals::MAP_TILE_SIZE + Globals::MAP_TILE_SIZE / 2};
+            }
+        }
+        return {width * Globals::MAP_TILE_SIZE / 2, height * Globals::MAP_TILE_SIZE / 2};
+    }
+
+    // Distance sweep the way culling and hit testing read positions, through each object and through the store
+    void RunPositionSweeps(Area& area, const pdcpp::Point<int> center)
+    {
+        auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+        long long checksum = 0;
+
+        float startTime = system->getElapsedTime();
+        for (int pass = 0; pass < SWEEP_PASSES; ++pass)
+        {
+            for (const auto& monster : area.GetCreatures())
+            {
+                const pdcpp::Point<int> position = monster->GetPosition();
+                checksum += std::abs(position.x - center.x) + std::abs(position.y - center.y);
+            }
+        }
+        const int objectsUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+
+        startTime = system->getElapsedTime();
+        for (int pass = 0; pass < SWEEP_PASSES; ++pass)
+        {
+            for (const pdcpp::Point<int>& position : area.GetMonsterStore().GetPositions())
+            {
+                checksum -= std::abs(position.x - center.x) + std::abs(position.y - center.y);
+            }
+        }
+        const int storeUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+
+        // Both sweeps read the same positions, so the checksum cancels out
+        if (checksum != 0) Log::Error("Monster benchmark: store positions out of sync with the monsters");
+        Log::Info("Monster benchmark position sweep: objects %d us, store %d us", objectsUs, storeUs);
+    }
+}
+
+void MonsterBenchmark::Run()
+{
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    pdcpp::Random random;
+
+    auto area = std::make_shared<Area>();
+    area->SetMonstersSpawnedCount(Globals::MONSTER_TOTAL_TO_SPAWN); // only the benchmark monsters, no spawning
+    area->GenerateProceduralMap(MAP_SIZE, MAP_SIZE, nullptr);
+    area->LoadFromSavedData();
+    const MapCollision* collider = area->GetCollider();
+    if (!collider) return;
+
+    auto player = std::make_shared<Player>();
+    player->SetPosition(RandomWalkablePixel(*collider, random));
+    player->SetMaxHP(1000000.0f); // survives the whole run
+    player->SetHP(1000000.0f);
+
+    // A stress test: the monsters are added directly instead of through SpawnCreature, so neither
+    // MONSTER_MAX_LIVING_COUNT nor the MonsterPool applies and each one is allocated here
+    const Monster prototype(0, "Bench", "", 10, 1, 1, 1, 0, 1, 0, 0);
+    for (int i = 0; i < Globals::MONSTER_BENCHMARK_COUNT; ++i)
+    {
+        auto monster = std::make_shared<Monster>(prototype);
+        monster->SetMovementType(MOVEMENT_TYPES[i % std::size(MOVEMENT_TYPES)]);
+        monster->SetPosition(RandomWalkablePixel(*collider, random));
+        area->AddLivingMonster(monster);
+    }
+
+    RunPositionSweeps(*area, player->GetPosition());
+
+    const float startTime = system->getElapsedTime();
+    for (int tick = 0; tick < Globals::MONSTER_BENCHMARK_TICKS; ++tick)
+    {
+        area->Tick(player.get());
+    }
+    const int elapsedUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+    Log::Info("Monster benchmark: %d ticks with %d monsters (game cap %d), %d us",
+              Globals::MONSTER_BENCHMARK_TICKS, Globals::MONSTER_BENCHMARK_COUNT, Globals::MONSTER_MAX_LIVING_COUNT, elapsedUs);
+
+    area->Unload();
+}
@@ -0,0 +1,18 @@
+#ifndef CARDOBLAST_MONSTERBENCHMARK_H
+#define CARDOBLAST_MONSTERBENCHMARK_H
+
+/**
+ * @brief Development benchmark ticking an area crowded with monsters.
+ *
+ * Fills a procedural area with Globals::MONSTER_BENCHMARK_COUNT monsters and logs the time
+ * of Globals::MONSTER_BENCHMARK_TICKS area ticks. The monsters are added directly, past the
+ * game's MONSTER_MAX_LIVING_COUNT cap, to measure how the tick scales. The position sweep done by culling and hit
+ * testing is timed twice, once reading every Monster object (the old layout) and once reading
+ * the MonsterStore arrays. Only runs when Globals::RUN_MONSTER_BENCHMARK is enabled.
+ */
+namespace MonsterBenchmark
+{
+    void Run();
+}
+
+#endif //CARDOBLAST_MONSTERBENCHMARK_H
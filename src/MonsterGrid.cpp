@@ -0,0 +1,111 @@
+#include "MonsterGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void MonsterGrid::Reset(const int pixelWidth, const int pixelHeight, const int _cellSize)
+{
+    cellSize = std::max(1, _cellSize);
+    columns = std::max(1, (pixelWidth + cellSize - 1) / cellSize);
+    rows = std::max(1, (pixelHeight + cellSize - 1) / cellSize);
+    cells.assign(static_cast<size_t>(columns) * rows, {});
+    count = 0;
+}
+
+void MonsterGrid::Clear()
+{
+    for (auto& cell : cells)
+    {
+        cell.clear();
+    }
+    count = 0;
+}
+
+int MonsterGrid::CellOf(const pdcpp::Point<int> position) const
+{
+    const int x = std::clamp(position.x / cellSize, 0, columns - 1);
+    const int y = std::clamp(position.y / cellSize, 0, rows - 1);
+    return y * columns + x;
+}
+
+MonsterGrid::CellRange MonsterGrid::CellsAround(const float minX, const float minY, const float maxX, const float maxY) const
+{
+    // Clamping keeps the border cells, where monsters outside the map are stored
+    const auto toCell = [this](const float pixel, const int limit)
+    {
+        return std::clamp(static_cast<int>(std::floor(pixel / static_cast<float>(cellSize))), 0, limit - 1);
+    };
+    return {toCell(minX, columns), toCell(minY, rows), toCell(maxX, columns), toCell(maxY, rows)};
+}
+
+int MonsterGrid::Insert(const int slot, const pdcpp::Point<int> position)
+{
+    if (cells.empty()) return NO_CELL;
+
+    const int cell = CellOf(position);
+    cells[cell].push_back(slot);
+    count++;
+    return cell;
+}
+
+int MonsterGrid::Remove(const int slot, const int cell)
+{
+    if (cell < 0 || cell >= static_cast<int>(cells.size())) return NO_CELL;
+
+    auto& bucket = cells[cell];
+    const auto it = std::find(bucket.begin(), bucket.end(), slot);
+    if (it != bucket.end())
+    {
+        *it = bucket.back(); // order inside a cell doesn't matter
+        bucket.pop_back();
+        count--;
+    }
+    return NO_CELL;
+}
+
+int MonsterGrid::Move(const int slot, const int cell, const pdcpp::Point<int> position)
+{
+    if (cells.empty()) return NO_CELL;
+    if (cell == CellOf(position)) return cell;
+    Remove(slot, cell);
+    return Insert(slot, position);
+}
+
+void MonsterGrid::Rename(const int cell, const int oldSlot, const int newSlot)
+{
+    if (cell < 0 || cell >= static_cast<int>(cells.size())) return;
+    auto& bucket = cells[cell];
+    std::replace(bucket.begin(), bucket.end(), oldSlot, newSlot);
+}
+
+const std::vector<int>& MonsterGrid::GetCandidates(const HitShape& shape)
+{
+    results.clear();
+    if (cells.empty() || shape.type == HitShape::Type::None) return results;
+
+    float minX, minY, maxX, maxY;
+    shape.GetBounds(minX, minY, maxX, maxY);
+    const CellRange range = CellsAround(minX, minY, maxX, maxY);
+    for (int y = range.minY; y <= range.maxY; ++y)
+    {
+        for (int x = range.minX; x <= range.maxX; ++x)
+        {
+            const auto& cell = cells[y * columns + x];
+            if (cell.empty()) continue;
+
+            // Border cells may hold monsters outside the map, so they're always taken
+            const auto left = static_cast<float>(x * cellSize);
+            const auto top = static_cast<float>(y * cellSize);
+            if (!IsBorderCell(x, y) && !shape.MayOverlap(left, top, left + static_cast<float>(cellSize), top + static_cast<float>(cellSize))) continue;
+
+            results.insert(results.end(), cell.begin(), cell.end());
+        }
+    }
+    return results;
+}
+
+const std::vector<int>& MonsterGrid::Query(const HitShape& shape, const std::vector<pdcpp::Point<int>>& positions)
+{
+    GetCandidates(shape);
+    std::erase_if(results, [&](const int slot) { return !shape.Contains(positions[slot]); });
+    return results;
+}
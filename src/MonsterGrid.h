@@ -0,0 +1,70 @@
+#ifndef CARDOBLAST_MONSTERGRID_H
+#define CARDOBLAST_MONSTERGRID_H
+
+#include "HitShape.h"
+#include "pdcpp/graphics/Point.h"
+#include <vector>
+
+/**
+ * @brief Uniform grid in pixels bucketing monster slots by position.
+ *
+ * Owned by the MonsterStore, which keeps it in sync with its position array. Hit tests and
+ * targeting ask it for the slots around a shape instead of testing every monster, so they
+ * cost about the number of monsters near the shape. A slot only changes cell when its
+ * monster crosses into another one.
+ *
+ * Query results live in a buffer reused between calls, so they're only valid until the next query.
+ * Monsters outside the map are kept in the closest border cell.
+ */
+class MonsterGrid
+{
+public:
+    static constexpr int NO_CELL = -1;
+
+    MonsterGrid() = default;
+
+    /**
+     * @brief Size the grid for a new map. Every slot has to be inserted again.
+     */
+    void Reset(int pixelWidth, int pixelHeight, int cellSize);
+    void Clear();
+
+    // All of them return the cell the slot is in afterwards
+    int Insert(int slot, pdcpp::Point<int> position);
+    int Remove(int slot, int cell);
+    int Move(int slot, int cell, pdcpp::Point<int> position); // only touches the cells if it crossed into another one
+    // The store moved a monster to another slot
+    void Rename(int cell, int oldSlot, int newSlot);
+
+    /**
+     * @brief Broad phase: every slot in a cell the shape may overlap, without testing its position.
+     */
+    const std::vector<int>& GetCandidates(const HitShape& shape);
+    // Slots whose position is inside the shape
+    const std::vector<int>& Query(const HitShape& shape, const std::vector<pdcpp::Point<int>>& positions);
+
+    [[nodiscard]] int GetCount() const { return count; }
+    [[nodiscard]] int GetCellSize() const { return cellSize; }
+
+private:
+    struct CellRange
+    {
+        int minX;
+        int minY;
+        int maxX;
+        int maxY;
+    };
+
+    [[nodiscard]] int CellOf(pdcpp::Point<int> position) const;
+    [[nodiscard]] bool IsBorderCell(int x, int y) const { return x == 0 || y == 0 || x == columns - 1 || y == rows - 1; }
+    [[nodiscard]] CellRange CellsAround(float minX, float minY, float maxX, float maxY) const;
+
+    std::vector<std::vector<int>> cells; // row-major
+    std::vector<int> results; // reused by the queries
+    int columns = 0;
+    int rows = 0;
+    int cellSize = 1;
+    int count = 0;
+};
+
+#endif //CARDOBLAST_MONSTERGRID_H
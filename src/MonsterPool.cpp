@@ -0,0 +1,52 @@
+#include "MonsterPool.h"
+#include "Monster.h"
+#include <algorithm>
+
+void MonsterPool::Reserve(const int capacity)
+{
+    if (capacity <= GetCapacity()) return;
+
+    instances.reserve(capacity);
+    inUse.reserve(capacity);
+    freeSlots.reserve(capacity);
+    for (int slot = GetCapacity(); slot < capacity; ++slot)
+    {
+        instances.push_back(std::make_shared<Monster>());
+        inUse.push_back(0);
+        freeSlots.push_back(slot);
+    }
+}
+
+std::shared_ptr<Monster> MonsterPool::Acquire(const Monster& prototype)
+{
+    if (freeSlots.empty()) return nullptr;
+
+    const int slot = freeSlots.back();
+    freeSlots.pop_back();
+    inUse[slot] = 1;
+    highWaterMark = std::max(highWaterMark, GetInUse());
+
+    *instances[slot] = prototype;
+    instances[slot]->SetPoolSlot(slot);
+    return instances[slot];
+}
+
+void MonsterPool::Release(Monster& monster)
+{
+    const int slot = monster.GetPoolSlot();
+    if (slot < 0 || slot >= GetCapacity() || instances[slot].get() != &monster) return; // not one of ours
+    if (!inUse[slot]) return;
+    monster.SetPoolSlot(-1);
+    inUse[slot] = 0;
+    freeSlots.push_back(slot);
+}
+
+void MonsterPool::ReleaseAll()
+{
+    freeSlots.clear();
+    for (int slot = 0; slot < GetCapacity(); ++slot)
+    {
+        inUse[slot] = 0;
+        freeSlots.push_back(slot);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef CARDOBLAST_MONSTERPOOL_H
+#define CARDOBLAST_MONSTERPOOL_H
+
+#include <memory>
+#include <vector>
+
+class Monster;
+
+/**
+ * @brief Fixed set of monster instances recycled between spawns.
+ *
+ * The instances are allocated once by Reserve. Acquire re-initialises a free one from a
+ * prototype of the area's bank (copy assignment, which reuses the buffers the instance
+ * already owns) and Release gives it back when the monster dies, so steady-state play
+ * doesn't allocate monsters.
+ *
+ * An instance remembers its slot (Monster::GetPoolSlot), so releasing it is constant time.
+ * Monsters that weren't acquired here (benchmarks, tools) can still live in the area,
+ * releasing them does nothing.
+ *
+ * The instances never die, so nothing may keep one across a Release. Other systems hold
+ * MonsterStore handles instead, and the area removes the monster from its store in the same
+ * step as it releases it (Area::DespawnMonster), which makes every handle to it stop resolving
+ * before the instance can be handed out again.
+ */
+class MonsterPool
+{
+public:
+    MonsterPool() = default;
+    // The instances are handed out as shared pointers, a copy would share them
+    MonsterPool(const MonsterPool&) = delete;
+    MonsterPool& operator=(const MonsterPool&) = delete;
+
+    // Allocate the instances. Does nothing if the pool already has that many.
+    void Reserve(int capacity);
+    /**
+     * @brief Re-initialise a free instance from `prototype`.
+     * @return nullptr if every instance is in use
+     */
+    std::shared_ptr<Monster> Acquire(const Monster& prototype);
+    void Release(Monster& monster);
+    void ReleaseAll();
+
+    [[nodiscard]] int GetCapacity() const { return static_cast<int>(instances.size()); }
+    [[nodiscard]] int GetInUse() const { return GetCapacity() - static_cast<int>(freeSlots.size()); }
+    [[nodiscard]] int GetHighWaterMark() const { return highWaterMark; } // most instances in use at once
+
+private:
+    std::vector<std::shared_ptr<Monster>> instances;
+    std::vector<unsigned char> inUse; // per instance
+    std::vector<int> freeSlots; // stack of instance indices
+    int highWaterMark = 0;
+};
+
+#endif //CARDOBLAST_MONSTERPOOL_H
@@ -0,0 +1,63 @@
+#include "MonsterPrototypes.h"
+#include "SpriteAtlas.h"
+
+std::vector<MonsterPrototypes::Entry> MonsterPrototypes::entries;
+
+int MonsterPrototypes::Register(const Monster& monster)
+{
+    for (int index = 0; index < Count(); ++index)
+    {
+        if (entries[index].prototype.id == monster.GetId()) return index;
+    }
+
+    const int index = Count();
+    Entry& entry = entries.emplace_back();
+    MonsterPrototype& prototype = entry.prototype;
+    prototype.id = monster.GetId();
+    prototype.name = monster.GetName();
+    prototype.imagePath = monster.GetImagePath();
+    prototype.description = monster.GetDescription();
+    prototype.maxHp = monster.GetMaxHP();
+    prototype.strength = monster.GetStrength();
+    prototype.agility = monster.GetAgility();
+    prototype.constitution = monster.GetConstitution();
+    prototype.evasion = monster.GetEvasion();
+    prototype.xp = monster.GetXP();
+    prototype.movementType = monster.GetMovementType();
+
+    // The strings only live in the prototype
+    entry.instanceTemplate = monster;
+    entry.instanceTemplate.SetName("");
+    entry.instanceTemplate.SetImagePath("");
+    entry.instanceTemplate.SetDescription("");
+    entry.instanceTemplate.SetPrototypeIndex(index);
+    return index;
+}
+
+int MonsterPrototypes::IndexOf(const Monster& monster)
+{
+    if (monster.GetPrototypeIndex() >= 0) return monster.GetPrototypeIndex();
+    return Register(monster);
+}
+
+const Monster& MonsterPrototypes::GetInstanceTemplate(const int index)
+{
+    Entry& entry = entries[index];
+    if (!entry.bitmapLoaded)
+    {
+        // Taken from the shared monster atlas, or through the bitmap cache once. Then the path is dropped again.
+        const SpriteAtlas* atlas = Globals::ANIMATION_ATLAS ? SpriteAtlas::Get(Globals::MONSTER_ATLAS_PATH) : nullptr;
+        const SpriteAtlas::Clip sprite = atlas ? atlas->FindClip(entry.prototype.imagePath) : SpriteAtlas::Clip();
+        if (sprite.IsValid())
+        {
+            entry.instanceTemplate.SetAtlasSprite(atlas, sprite.first);
+        }
+        else
+        {
+            entry.instanceTemplate.LoadBitmap(entry.prototype.imagePath);
+        }
+        entry.instanceTemplate.SetImagePath("");
+        entry.bitmapLoaded = true;
+    }
+    return entry.instanceTemplate;
+}
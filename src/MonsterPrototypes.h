@@ -0,0 +1,62 @@
+#ifndef CARDOBLAST_MONSTERPROTOTYPES_H
+#define CARDOBLAST_MONSTERPROTOTYPES_H
+
+#include "Monster.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Immutable part of a creature definition from creatures.json.
+ */
+struct MonsterPrototype
+{
+    unsigned int id = 0;
+    std::string name;
+    std::string imagePath;
+    std::string description;
+    float maxHp = 0;
+    int strength = 0;
+    int agility = 0;
+    int constitution = 0;
+    float evasion = 0;
+    unsigned int xp = 0;
+    Monster::MovementType movementType = Monster::MovementType::AStar;
+};
+
+/**
+ * @brief Table of monster prototypes, each definition stored once.
+ *
+ * Monster::DecodeJson registers every creature it reads and the monster keeps the index.
+ * Next to each prototype the table keeps an instance template: a Monster with the base stats
+ * and the bitmap, but without the name, image path and description strings. Spawned monsters
+ * are copied from the template, so a spawn copies plain fields only and never looks up the
+ * bitmap cache. The strings stay here, reachable through Monster::GetPrototypeIndex.
+ */
+class MonsterPrototypes
+{
+public:
+    // Index of the prototype with the monster's id, registering it if it's the first one
+    static int Register(const Monster& monster);
+    // The monster's prototype index, registering it if the monster wasn't decoded from JSON
+    static int IndexOf(const Monster& monster);
+    [[nodiscard]] static const MonsterPrototype& Get(int index) { return entries[index].prototype; }
+    /**
+     * @brief Monster to copy spawned instances from.
+     *
+     * The bitmap is loaded on the first call, so monsters that never spawn don't load theirs.
+     */
+    [[nodiscard]] static const Monster& GetInstanceTemplate(int index);
+    [[nodiscard]] static int Count() { return static_cast<int>(entries.size()); }
+
+private:
+    struct Entry
+    {
+        MonsterPrototype prototype;
+        Monster instanceTemplate;
+        bool bitmapLoaded = false;
+    };
+
+    static std::vector<Entry> entries;
+};
+
+#endif //CARDOBLAST_MONSTERPROTOTYPES_H
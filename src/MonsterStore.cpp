@@ -0,0 +1,148 @@
+#include "MonsterStore.h"
+#include "Globals.h"
+#include "Monster.h"
+
+void MonsterStore::Reset(const int pixelWidth, const int pixelHeight)
+{
+    grid.Reset(pixelWidth, pixelHeight, Globals::MONSTER_GRID_CELL_SIZE);
+    for (int slot = 0; slot < Size(); ++slot)
+    {
+        occupying[slot] = 0;
+        gridCells[slot] = grid.Insert(slot, positions[slot]);
+        planners[slot].reset();
+    }
+}
+
+int MonsterStore::Add(const std::shared_ptr<Monster>& monster)
+{
+    const int slot = Size();
+    monsters.push_back(monster);
+    positions.push_back(monster->GetPosition());
+    tiledPositions.push_back(monster->GetTiledPosition());
+    occupiedTiles.push_back({0, 0});
+    occupying.push_back(0);
+    gridCells.push_back(grid.Insert(slot, positions.back()));
+    planners.emplace_back();
+
+    int handle;
+    if (freeHandles.empty())
+    {
+        handle = static_cast<int>(handleSlots.size());
+        handleSlots.push_back(slot);
+        handleGenerations.push_back(0);
+    }
+    else
+    {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        handleSlots[handle] = slot;
+    }
+    slotHandles.push_back(handle);
+    return slot;
+}
+
+void MonsterStore::Remove(const int slot)
+{
+    grid.Remove(slot, gridCells[slot]);
+
+    // Outstanding handles to this monster stop resolving
+    const int handle = slotHandles[slot];
+    handleSlots[handle] = -1;
+    ++handleGenerations[handle];
+    freeHandles.push_back(handle);
+
+    // Move the last monster into the hole, so the arrays stay packed
+    const int last = Size() - 1;
+    if (slot != last)
+    {
+        monsters[slot] = std::move(monsters[last]);
+        positions[slot] = positions[last];
+        tiledPositions[slot] = tiledPositions[last];
+        occupiedTiles[slot] = occupiedTiles[last];
+        occupying[slot] = occupying[last];
+        gridCells[slot] = gridCells[last];
+        grid.Rename(gridCells[slot], last, slot);
+        planners[slot] = std::move(planners[last]);
+        slotHandles[slot] = slotHandles[last];
+        handleSlots[slotHandles[slot]] = slot;
+    }
+    monsters.pop_back();
+    positions.pop_back();
+    tiledPositions.pop_back();
+    occupiedTiles.pop_back();
+    occupying.pop_back();
+    gridCells.pop_back();
+    planners.pop_back();
+    slotHandles.pop_back();
+}
+
+void MonsterStore::Clear()
+{
+    monsters.clear();
+    positions.clear();
+    tiledPositions.clear();
+    occupiedTiles.clear();
+    occupying.clear();
+    gridCells.clear();
+    planners.clear();
+    grid.Clear();
+
+    for (const int handle : slotHandles)
+    {
+        handleSlots[handle] = -1;
+        ++handleGenerations[handle];
+        freeHandles.push_back(handle);
+    }
+    slotHandles.clear();
+}
+
+void MonsterStore::Sync(const int slot)
+{
+    const Monster& monster = *monsters[slot];
+    positions[slot] = monster.GetPosition();
+    tiledPositions[slot] = monster.GetTiledPosition();
+    gridCells[slot] = grid.Move(slot, gridCells[slot], positions[slot]);
+}
+
+DStarLite& MonsterStore::GetPlanner(const int slot)
+{
+    if (!planners[slot]) planners[slot] = std::make_unique<DStarLite>();
+    return *planners[slot];
+}
+
+GenerationalHandle MonsterStore::GetHandle(const int slot) const
+{
+    const int handle = slotHandles[slot];
+    return {handle, handleGenerations[handle]};
+}
+
+int MonsterStore::Resolve(const GenerationalHandle handle) const
+{
+    if (handle.index < 0 || handle.index >= static_cast<int>(handleSlots.size())) return -1;
+    if (handleGenerations[handle.index] != handle.generation) return -1;
+    return handleSlots[handle.index];
+}
+
+Monster* MonsterStore::Get(const GenerationalHandle handle) const
+{
+    const int slot = Resolve(handle);
+    return slot < 0 ? nullptr : monsters[slot].get();
+}
+
+int MonsterStore::FindNearest(const pdcpp::Point<int> center, const float maxDistance)
+{
+    int nearest = -1;
+    float bestSquared = maxDistance * maxDistance;
+    for (const int slot : grid.GetCandidates(HitShape::Circle(center, maxDistance)))
+    {
+        const auto dx = static_cast<float>(positions[slot].x - center.x);
+        const auto dy = static_cast<float>(positions[slot].y - center.y);
+        const float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared > bestSquared || (nearest >= 0 && distanceSquared == bestSquared)) continue;
+        if (!monsters[slot]->IsAlive()) continue;
+
+        bestSquared = distanceSquared;
+        nearest = slot;
+    }
+    return nearest;
+}
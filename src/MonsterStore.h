@@ -0,0 +1,101 @@
+#ifndef CARDOBLAST_MONSTERSTORE_H
+#define CARDOBLAST_MONSTERSTORE_H
+
+#include "DStarLite.h"
+#include "GenerationalHandle.h"
+#include "HitShape.h"
+#include "MonsterGrid.h"
+#include "pdcpp/graphics/Point.h"
+#include <memory>
+#include <vector>
+
+class Monster;
+
+/**
+ * @brief Living monsters of an area, as parallel arrays indexed by slot.
+ *
+ * The per-frame loops of the area (occupancy bookkeeping, culling, hit testing) only need
+ * a few fields of each monster. Those live here in contiguous arrays instead of being read
+ * through each Monster object, which drags its strings, particles and inventory along.
+ * The Monster objects keep the behaviour and the rest of the state, and the area calls
+ * Sync after a monster moved to copy its position back.
+ *
+ * Removing a monster moves the last one into its slot, so slots are only stable until the next removal.
+ * References that have to outlive a tick (projectile targets, path requests) hold a GenerationalHandle
+ * instead: the store maps it to the current slot, and stops resolving it once that monster is removed.
+ *
+ * The D* Lite planners of the kiting monsters live here too, one per slot. Their buffers grow
+ * with the map (see Globals::DSTAR_MAX_MAP_TILES), so they're freed with the living monster
+ * rather than kept by its pooled instance.
+ */
+class MonsterStore
+{
+public:
+    MonsterStore() = default;
+
+    /**
+     * @brief Size the hit testing grid for a new map and put every monster back in it.
+     *
+     * The occupancy bookkeeping and the planners are cleared too, since a new map comes with a new collider.
+     */
+    void Reset(int pixelWidth, int pixelHeight);
+    int Add(const std::shared_ptr<Monster>& monster);
+    void Remove(int slot);
+    void Clear();
+    // Copy the position of the monster object, after it moved
+    void Sync(int slot);
+
+    [[nodiscard]] int Size() const { return static_cast<int>(monsters.size()); }
+    [[nodiscard]] bool Empty() const { return monsters.empty(); }
+    [[nodiscard]] const std::shared_ptr<Monster>& GetMonster(int slot) const { return monsters[slot]; }
+    [[nodiscard]] const std::vector<std::shared_ptr<Monster>>& GetMonsters() const { return monsters; }
+    [[nodiscard]] const std::vector<pdcpp::Point<int>>& GetPositions() const { return positions; }
+    [[nodiscard]] pdcpp::Point<int> GetPosition(int slot) const { return positions[slot]; }
+    [[nodiscard]] pdcpp::Point<int> GetTiledPosition(int slot) const { return tiledPositions[slot]; }
+
+    [[nodiscard]] GenerationalHandle GetHandle(int slot) const;
+    // Current slot of the monster, or -1 if it was removed
+    [[nodiscard]] int Resolve(GenerationalHandle handle) const;
+    // nullptr if the monster was removed
+    [[nodiscard]] Monster* Get(GenerationalHandle handle) const;
+
+    // D* Lite planner of the slot, created on first use and freed when the monster is removed
+    DStarLite& GetPlanner(int slot);
+    // nullptr if the slot hasn't planned yet
+    [[nodiscard]] const DStarLite* FindPlanner(int slot) const { return planners[slot].get(); }
+
+    // Tile the slot is counted on in the collider's occupancy layer. Kept up to date by the Area.
+    [[nodiscard]] bool IsOccupyingTile(int slot) const { return occupying[slot] != 0; }
+    [[nodiscard]] pdcpp::Point<int> GetOccupiedTile(int slot) const { return occupiedTiles[slot]; }
+    void SetOccupiedTile(int slot, pdcpp::Point<int> tile) { occupiedTiles[slot] = tile; occupying[slot] = 1; }
+    void ClearOccupiedTile(int slot) { occupying[slot] = 0; }
+
+    // Hit testing. Results are slots, valid until the next query or removal.
+    const std::vector<int>& GetCandidates(const HitShape& shape) { return grid.GetCandidates(shape); }
+    const std::vector<int>& Query(const HitShape& shape) { return grid.Query(shape, positions); }
+
+    /**
+     * @brief Closest living monster within `maxDistance` of `center`.
+     * @return its slot, or -1 if there's none
+     */
+    [[nodiscard]] int FindNearest(pdcpp::Point<int> center, float maxDistance);
+    [[nodiscard]] const MonsterGrid& GetGrid() const { return grid; }
+
+private:
+    std::vector<std::shared_ptr<Monster>> monsters; // behaviour and cold state
+    std::vector<pdcpp::Point<int>> positions; // pixels
+    std::vector<pdcpp::Point<int>> tiledPositions;
+    std::vector<pdcpp::Point<int>> occupiedTiles;
+    std::vector<unsigned char> occupying;
+    std::vector<int> gridCells;
+    std::vector<int> slotHandles; // handle index of each slot
+    std::vector<std::unique_ptr<DStarLite>> planners; // nullptr until the slot plans
+    MonsterGrid grid;
+
+    // Handle table, indexed by handle index. Freed indices are reused with the next generation.
+    std::vector<int> handleSlots; // -1 while free
+    std::vector<unsigned int> handleGenerations;
+    std::vector<int> freeHandles;
+};
+
+#endif //CARDOBLAST_MONSTERSTORE_H
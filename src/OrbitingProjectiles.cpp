@@ -7,13 +7,13 @@
 #include "EntityManager.h"
 #include "Monster.h"
 
-OrbitingProjectiles::OrbitingProjectiles(const pdcpp::Point<int> Position, std::weak_ptr<Player> _player)
-    : OrbitingProjectiles(Position, std::move(_player), 10, 40, 0.1f)
+OrbitingProjectiles::OrbitingProjectiles(const pdcpp::Point<int> Position, Player* _player)
+    : OrbitingProjectiles(Position, _player, 10, 40, 0.1f)
 {}
 
-OrbitingProjectiles::OrbitingProjectiles(const pdcpp::Point<int> Position, std::weak_ptr<Player> _player,
+OrbitingProjectiles::OrbitingProjectiles(const pdcpp::Point<int> Position, Player* _player,
                                          unsigned int _size, short int _radius, float _damage) :
-        Magic(Position, std::move(_player)) {
+        Magic(Position, _player) {
     iLifetime = 4000;
     size = _size;
     radius = _radius;
@@ -30,9 +30,8 @@ void OrbitingProjectiles::Draw() const
 }
 
 void OrbitingProjectiles::HandleInput() {
-    std::shared_ptr<Player> p = player.lock();
-    if (!p) return; // player was destroyed
-    position = p->GetCenteredPosition();
+    if (!player) return;
+    position = player->GetCenteredPosition();
     const float angle = pdcpp::GlobalPlaydateAPI::get()->system->getCrankChange()* kPI /180.f;
 
     for (int i=0; i< sizeof(angles) / sizeof(angles[0]); i++)
@@ -45,34 +44,31 @@ void OrbitingProjectiles::HandleInput() {
     }
 }
 
-void OrbitingProjectiles::Damage(const std::shared_ptr<Area>& area)
+HitShape OrbitingProjectiles::GetHitShape() const
 {
-    std::shared_ptr<Player> p = player.lock();
-    if (!p) return; //Player has been destroyed
-    position = p->GetCenteredPosition();
-    for (const auto& entity : area->GetCreatures())
+    // The ring swept by the projectiles is the first filter, the angle of each one is checked in OnHit
+    const float innerRadius = static_cast<float>(radius) - static_cast<float>(size/2);
+    const float outerRadius = static_cast<float>(radius) + static_cast<float>(size/2);
+    return HitShape::Ring(position, innerRadius, outerRadius);
+}
+
+void OrbitingProjectiles::OnHit(Monster& monster)
+{
+    const pdcpp::Point<int> creaturePos = monster.GetPosition();
+    // Calculate the angle between the projectile and the creature.
+    const auto angle = static_cast<float>(atan2(creaturePos.y - position.y, creaturePos.x - position.x));
+    //Log::Info("Angle creature: %f, angles projectile: %f", angle, angles[0]);
+    //angles[0] comes in the range of 0 to 2*PI
+    //angle comes in the range of -PI to PI
+    for (int i=0; i< sizeof(angles) / sizeof(angles[0]); i++)
     {
-        const pdcpp::Point<int> creaturePos = entity->GetPosition();
-        // Calculate the distance between the projectile and the creature as a first filter,
-        auto distance = static_cast<float>(sqrt(pow(position.x - creaturePos.x, 2) + pow(position.y - creaturePos.y, 2)));
-        if (distance < static_cast<float>(radius + (size/2)) && distance > static_cast<float>(radius - (size/2)))
+        // Normalize the angle to the range of 0 to 2*PI
+        float normalizedAngle = fmod(angle + 2 * kPI, 2 * kPI);
+        if (abs(normalizedAngle - angles[i]) < 0.2f)
         {
-            // Calculate the angle between the projectile and the creature.
-            const auto angle = static_cast<float>(atan2(creaturePos.y - position.y, creaturePos.x - position.x));
-            //Log::Info("Angle creature: %f, angles projectile: %f", angle, angles[0]);
-            //angles[0] comes in the range of 0 to 2*PI
-            //angle comes in the range of -PI to PI
-            for (int i=0; i< sizeof(angles) / sizeof(angles[0]); i++)
-            {
-                // Normalize the angle to the range of 0 to 2*PI
-                float normalizedAngle = fmod(angle + 2 * kPI, 2 * kPI);
-                if (abs(normalizedAngle - angles[i]) < 0.2f)
-                {
-                    // Damage the creature
-                    entity->Damage(damagePerHit);
-                    break;
-                }
-            }
+            // Damage the creature
+            monster.Damage(damagePerHit);
+            break;
         }
     }
 }
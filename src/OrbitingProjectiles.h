@@ -9,16 +9,17 @@
 #include "Magic.h"
 #include "pdcpp/core/util.h"
 
-class OrbitingProjectiles : public Magic{
+class OrbitingProjectiles final : public Magic{
 public:
     OrbitingProjectiles() = delete;
-    explicit OrbitingProjectiles(pdcpp::Point<int> Position, std::weak_ptr<Player> player);
-    OrbitingProjectiles(pdcpp::Point<int> Position, std::weak_ptr<Player> player, unsigned int size, short int radius, float damage);
+    explicit OrbitingProjectiles(pdcpp::Point<int> Position, Player* player);
+    OrbitingProjectiles(pdcpp::Point<int> Position, Player* player, unsigned int size, short int radius, float damage);
     bool operator==(const OrbitingProjectiles& other) const {return this == &other;}
 
     void Draw() const override;
     void HandleInput() override;
-    void Damage(const std::shared_ptr<Area>& area) override;
+    [[nodiscard]] HitShape GetHitShape() const override;
+    void OnHit(Monster& monster) override;
 
 private:
     unsigned int size;
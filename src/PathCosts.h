@@ -0,0 +1,38 @@
+#ifndef CARDOBLAST_PATHCOSTS_H
+#define CARDOBLAST_PATHCOSTS_H
+
+#include "pdcpp/graphics/Point.h"
+
+/**
+ * @brief Step costs, neighbour order and heuristic of every grid search.
+ *
+ * MapCollision's A* and JPS, the flow field, the hierarchical pathfinder and D* Lite
+ * hand paths to the same monsters and are checked against each other, so they must
+ * agree on what a path costs. Costs are fixed point: a straight step is 10 and a diagonal one
+ * 14 (~10 * sqrt(2)), so no search needs a square root or a float compare.
+ */
+namespace PathCosts
+{
+    constexpr unsigned int STRAIGHT_COST = 10;
+    constexpr unsigned int DIAGONAL_COST = 14;
+
+    // The four straight neighbours come first, then the diagonals
+    constexpr int NEIGHBOUR_COUNT = 8;
+    constexpr int NEIGHBOUR_DX[NEIGHBOUR_COUNT] = {1, -1, 0, 0, 1, 1, -1, -1};
+    constexpr int NEIGHBOUR_DY[NEIGHBOUR_COUNT] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+    // Cost of the cheapest 8-connected walk between two tiles on open ground
+    [[nodiscard]] constexpr unsigned int OctileDistance(const int ax, const int ay, const int bx, const int by)
+    {
+        const unsigned int dx = static_cast<unsigned int>(ax > bx ? ax - bx : bx - ax);
+        const unsigned int dy = static_cast<unsigned int>(ay > by ? ay - by : by - ay);
+        return dx > dy ? STRAIGHT_COST * (dx - dy) + DIAGONAL_COST * dy : STRAIGHT_COST * (dy - dx) + DIAGONAL_COST * dx;
+    }
+
+    [[nodiscard]] inline unsigned int OctileDistance(const pdcpp::Point<int>& a, const pdcpp::Point<int>& b)
+    {
+        return OctileDistance(a.x, a.y, b.x, b.y);
+    }
+}
+
+#endif //CARDOBLAST_PATHCOSTS_H
@@ -0,0 +1,75 @@
+#include "PathScheduler.h"
+#include "Area.h"
+#include "Globals.h"
+#include "Monster.h"
+#include "MonsterStore.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include <algorithm>
+#include <cstdlib>
+
+void PathScheduler::Request(const GenerationalHandle monster, const pdcpp::Point<int> monsterPosition, const pdcpp::Point<int> playerPosition)
+{
+    // Pixel distance, so being on screen matches what the renderer draws
+    const int dx = std::abs(monsterPosition.x - playerPosition.x);
+    const int dy = std::abs(monsterPosition.y - playerPosition.y);
+    const bool onScreen = dx <= Globals::PLAYER_FOV_X && dy <= Globals::PLAYER_FOV_Y;
+    const int priority = (std::max(dx, dy) / Globals::MAP_TILE_SIZE) + (onScreen ? 0 : Globals::PATHFINDING_OFFSCREEN_PRIORITY);
+
+    for (Entry& entry : queue)
+    {
+        if (entry.monster == monster)
+        {
+            entry.priority = priority;
+            return;
+        }
+    }
+    queue.push_back({monster, priority, 0, false});
+}
+
+void PathScheduler::Run(Area* area)
+{
+    frameStats = PathSchedulerStats();
+    const MonsterStore& monsters = area->GetMonsterStore();
+    std::erase_if(queue, [&monsters](const Entry& entry) { return monsters.Resolve(entry.monster) < 0; });
+
+    // Waiting frames count against the priority, so far away monsters aren't starved forever
+    std::sort(queue.begin(), queue.end(), [](const Entry& a, const Entry& b)
+    {
+        if (a.paused != b.paused) return a.paused;
+        return a.priority - a.waitedFrames < b.priority - b.waitedFrames;
+    });
+
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float startTime = system->getElapsedTime();
+    const auto elapsedUs = [&]() { return static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f); };
+
+    size_t next = 0;
+    for (; next < queue.size() && elapsedUs() < Globals::PATHFINDING_FRAME_BUDGET_US; ++next)
+    {
+        const int slot = monsters.Resolve(queue[next].monster);
+        bool done = slot < 0;
+        while (!done)
+        {
+            done = monsters.GetMonster(slot)->ProcessPathRequest(area, slot, Globals::PATHFINDING_SLICE_EXPANSIONS);
+            if (!done && elapsedUs() >= Globals::PATHFINDING_FRAME_BUDGET_US)
+            {
+                frameStats.paused++;
+                queue[next].paused = true;
+                break;
+            }
+        }
+        if (done)
+        {
+            frameStats.completed++;
+            queue[next].monster = {}; // removed below
+        }
+    }
+
+    std::erase_if(queue, [](Entry& entry)
+    {
+        entry.waitedFrames++;
+        return entry.monster.IsNull();
+    });
+    frameStats.queueDepth = static_cast<int>(queue.size());
+    frameStats.budgetUsedUs = elapsedUs();
+}
@@ -0,0 +1,57 @@
+#ifndef CARDOBLAST_PATHSCHEDULER_H
+#define CARDOBLAST_PATHSCHEDULER_H
+
+#include "GenerationalHandle.h"
+#include "pdcpp/graphics/Point.h"
+#include <vector>
+
+class Area;
+
+/**
+ * @brief Per-frame counters of the path scheduler.
+ */
+struct PathSchedulerStats
+{
+    int queueDepth = 0;   ///< Requests still waiting after this frame
+    int budgetUsedUs = 0; ///< Time spent running requests this frame (microseconds)
+    int completed = 0;    ///< Requests finished this frame
+    int paused = 0;       ///< Requests that ran out of budget mid-search and resume next frame
+};
+
+/**
+ * @brief Runs monster path requests within a fixed time budget per frame.
+ *
+ * Monsters flag a request during their tick. The area queues them, and on the next frame
+ * they run in priority order (on screen first, then closest to the player, older requests
+ * bubbling up) until Globals::PATHFINDING_FRAME_BUDGET_US is spent. Searches are run in slices
+ * of Globals::PATHFINDING_SLICE_EXPANSIONS, so a long one can pause and resume on a later frame.
+ * A paused request runs first on the next frame: the tile searches share the collider's workspace,
+ * and starting another one would throw its work away.
+ * Requests hold a handle into the area's MonsterStore, and are dropped when the monster is removed.
+ */
+class PathScheduler
+{
+public:
+    PathScheduler() = default;
+
+    void Request(GenerationalHandle monster, pdcpp::Point<int> monsterPosition, pdcpp::Point<int> playerPosition);
+    void Run(Area* area);
+    void Clear() { queue.clear(); }
+
+    [[nodiscard]] const PathSchedulerStats& GetFrameStats() const { return frameStats; }
+    [[nodiscard]] int GetQueueDepth() const { return static_cast<int>(queue.size()); }
+
+private:
+    struct Entry
+    {
+        GenerationalHandle monster; // null once done
+        int priority; // lower runs first
+        int waitedFrames;
+        bool paused; // ran out of budget mid-search
+    };
+
+    std::vector<Entry> queue;
+    PathSchedulerStats frameStats;
+};
+
+#endif //CARDOBLAST_PATHSCHEDULER_H
@@ -0,0 +1,133 @@
+#include "PathfindingBenchmark.h"
+#include "Globals.h"
+#include "Log.h"
+#include "MapCollision.h"
+#include "ProceduralMapGenerator.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/core/Random.h"
+#include <vector>
+
+namespace
+{
+    struct ModeInfo
+    {
+        int mode;
+        const char* name;
+    };
+
+    constexpr ModeInfo MODES[] = {
+        {MapCollision::PATH_ASTAR, "A*"},
+        {MapCollision::PATH_JPS, "JPS"},
+        {MapCollision::PATH_JPS_PLUS, "JPS+"},
+    };
+
+    constexpr ModeInfo OPEN_LISTS[] = {
+        {MapCollision::OPEN_LIST_HEAP, "heap"},
+        {MapCollision::OPEN_LIST_BUCKETS, "buckets"},
+    };
+
+    constexpr int MAP_SIZES[] = {Globals::DEFAULT_MAP_WIDTH, 128, 256};
+
+    Map_Layer ToMapLayer(const Layer& layer, int width, int height)
+    {
+        Map_Layer result(static_cast<size_t>(width) * height, MapCollision::BLOCKS_NONE);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = layer.tiles[i].collision ? MapCollision::BLOCKS_ALL : MapCollision::BLOCKS_NONE;
+        }
+        return result;
+    }
+
+    pdcpp::Point<int> RandomWalkableTile(const MapCollision& collider, pdcpp::Random& random)
+    {
+        const int width = collider.map_size.x;
+        const int height = collider.map_size.y;
+        for (int attempt = 0; attempt < 1000; ++attempt)
+        {
+            const int x = static_cast<int>(random.next() % static_cast<unsigned int>(width));
+            const int y = static_cast<int>(random.next() % static_cast<unsigned int>(height));
+            if (collider.isStaticWalkable(x, y)) return {x, y};
+        }
+        return {width / 2, height / 2};
+    }
+
+    // Sweeps the whole map with tile queries, the way searches and line checks hit the grid
+    void RunCollisionQueries(MapCollision& collider, const int size)
+    {
+        auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+        unsigned int queries = 0;
+        unsigned int valid = 0;
+        const float startTime = system->getElapsedTime();
+        for (int pass = 0; pass < Globals::COLLISION_BENCHMARK_PASSES; ++pass)
+        {
+            for (int y = 0; y < size; ++y)
+            {
+                for (int x = 0; x < size; ++x)
+                {
+                    if (collider.isValidPosition(static_cast<float>(x), static_cast<float>(y),
+                                                 MapCollision::MOVE_NORMAL, MapCollision::ENTITY_COLLIDE_ALL)) valid++;
+                    if (collider.isStaticWalkable(x, y)) valid++;
+                    queries += 2;
+                }
+            }
+        }
+        const int elapsedUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+        Log::Info("Collision benchmark %dx%d: %u queries (%u true), %d us", size, size, queries, valid, elapsedUs);
+    }
+}
+
+void PathfindingBenchmark::Run()
+{
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    ProceduralMapGenerator generator;
+    pdcpp::Random random;
+
+    for (const int size : MAP_SIZES)
+    {
+        const std::vector<Layer> layers = generator.GenerateMap(size, size);
+        if (layers.empty()) continue;
+
+        MapCollision collider;
+        collider.SetMap(ToMapLayer(layers[0], size, size), size, size);
+        RunCollisionQueries(collider, size);
+
+        // Same query set for every mode
+        std::vector<pdcpp::Point<int>> queries;
+        queries.reserve(Globals::PATHFINDING_BENCHMARK_QUERIES * 2);
+        for (int i = 0; i < Globals::PATHFINDING_BENCHMARK_QUERIES * 2; ++i)
+        {
+            queries.push_back(RandomWalkableTile(collider, random));
+        }
+
+        std::vector<pdcpp::Point<int>> path;
+        path.reserve(static_cast<size_t>(size) * 4);
+        const unsigned int limit = static_cast<unsigned int>(size * size); // no early cut, so every mode does the full search
+
+        for (const ModeInfo& openList : OPEN_LISTS)
+        {
+            collider.setOpenList(openList.mode);
+            for (const ModeInfo& info : MODES)
+            {
+                collider.resetPathStats();
+                unsigned int found = 0;
+                const float startTime = system->getElapsedTime();
+                for (size_t i = 0; i + 1 < queries.size(); i += 2)
+                {
+                    if (collider.ComputePath(queries[i], queries[i + 1], path, MapCollision::MOVE_NORMAL, limit, info.mode)
+                        && path.front() == queries[i + 1])
+                    {
+                        found++;
+                    }
+                }
+                const int elapsedUs = static_cast<int>((system->getElapsedTime() - startTime) * 1000000.0f);
+                const unsigned int expanded = collider.getPathStats().expanded_nodes;
+                const int expansionsPerSecond = elapsedUs > 0
+                    ? static_cast<int>(static_cast<float>(expanded) * 1000000.0f / static_cast<float>(elapsedUs)) : 0;
+
+                Log::Info("Pathfinding benchmark %dx%d %s %s: %u/%u found, %u expanded, %d us, %d expansions/s",
+                          size, size, info.name, openList.name, found, collider.getPathStats().queries,
+                          expanded, elapsedUs, expansionsPerSecond);
+            }
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef CARDOBLAST_PATHFINDINGBENCHMARK_H
+#define CARDOBLAST_PATHFINDINGBENCHMARK_H
+
+/**
+ * @brief Development benchmark comparing the MapCollision search modes.
+ *
+ * Generates procedural maps of a few sizes, runs the same random queries through every
+ * path mode with both open lists and logs expanded nodes, wall time and expansions per
+ * second for each. A sweep of tile queries over each map is timed as well. Only runs when
+ * Globals::RUN_PATHFINDING_BENCHMARK is enabled.
+ */
+namespace PathfindingBenchmark
+{
+    void Run();
+}
+
+#endif //CARDOBLAST_PATHFINDINGBENCHMARK_H
@@ -6,13 +6,14 @@
 #include "pdcpp/core/GlobalPlaydateAPI.h"
 #include "Log.h"
 #include "Beam.h"
+#include "DrawList.h"
 #include "Globals.h"
 #include "Projectile.h"
+#include "SpriteAtlas.h"
 #include "OrbitingProjectiles.h"
 #include "AutoProjectile.h"
 #include "Monster.h"
 #include "Area.h"
-#include <limits>
 #include <algorithm>
 
 Player::Player()
@@ -39,71 +40,49 @@ Player::Player()
 
     SetSize(pdcpp::Point<int>(Globals::PLAYER_SIZE, Globals::PLAYER_SIZE));
 
-    // Load idle animation frames (8 frames)
-    for (int i = 0; i < 8; i++)
+    // Frames come from the packed atlas when there's one, otherwise one image per frame
+    auto* system = pdcpp::GlobalPlaydateAPI::get()->system;
+    const float loadStartTime = system->getElapsedTime();
+    const SpriteAtlas* atlas = Globals::ANIMATION_ATLAS ? SpriteAtlas::Get(Globals::PLAYER_ATLAS_PATH) : nullptr;
+    auto loadAnimation = [atlas](AnimationClip& clip, const std::string& folder, const int frames, const int delay)
     {
-        std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
-        idle->AddImagePath("images/player/animations/fight-stance-idle-8-frames/south/frame_" + frameNum);
-    }
-    idle->SetDelay(4);
-    idle->LoadImages();
-
-    // Load walking animation frames for south direction (6 frames)
-    for (int i = 0; i < 6; i++)
-    {
-        std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
-        walkSouth->AddImagePath("images/player/animations/walking-6-frames/south/frame_" + frameNum);
-    }
-    walkSouth->SetDelay(2);
-    walkSouth->LoadImages();
-
-    // Load walking animation frames for north direction (6 frames)
-    for (int i = 0; i < 6; i++)
-    {
-        std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
-        walkNorth->AddImagePath("images/player/animations/walking-6-frames/north/frame_" + frameNum);
-    }
-    walkNorth->SetDelay(2);
-    walkNorth->LoadImages();
-
-    // Load walking animation frames for east direction (6 frames)
-    for (int i = 0; i < 6; i++)
-    {
-        std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
-        walkEast->AddImagePath("images/player/animations/walking-6-frames/east/frame_" + frameNum);
-    }
-    walkEast->SetDelay(2);
-    walkEast->LoadImages();
-
-    // Load attack animation frames (6 frames)
-    for (int i = 0; i < 6; i++)
-    {
-        std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
-        attack->AddImagePath("images/player/animations/fireball/south/frame_" + frameNum);
-    }
-    attack->SetDelay(0);
-    attack->LoadImages();
+        clip.SetDelay(delay);
+        if (clip.UseAtlas(atlas, folder)) return;
+        for (int i = 0; i < frames; i++)
+        {
+            std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
+            clip.AddImagePath("images/player/animations/" + folder + "/frame_" + frameNum);
+        }
+        clip.LoadImages();
+    };
+    loadAnimation(*idle, "fight-stance-idle-8-frames/south", 8, 4);
+    loadAnimation(*walkSouth, "walking-6-frames/south", 6, 2);
+    loadAnimation(*walkNorth, "walking-6-frames/north", 6, 2);
+    loadAnimation(*walkEast, "walking-6-frames/east", 6, 2);
+    loadAnimation(*attack, "fireball/south", 6, 0);
+    loadAnimation(*die, "falling-back-death/south", 7, 4);
 
-    // Load death animation frames (7 frames)
-    for (int i = 0; i < 7; i++)
+    const int loadUs = static_cast<int>((system->getElapsedTime() - loadStartTime) * 1000000.0f);
+    int frameCount = 0;
+    int imageBytes = atlas ? atlas->GetMemoryBytes() : 0;
+    for (const AnimationClip* clip : {idle.get(), walkSouth.get(), walkNorth.get(), walkEast.get(), attack.get(), die.get()})
     {
-        std::string frameNum = (i < 10) ? "00" + std::to_string(i) : "0" + std::to_string(i);
-        die->AddImagePath("images/player/animations/falling-back-death/south/frame_" + frameNum);
+        frameCount += clip->GetFrameCount();
+        imageBytes += clip->GetMemoryBytes();
     }
-    die->SetDelay(4);
-    die->LoadImages();
+    Log::Info("Player animations: %d frames, %d bytes of bitmaps, %d us (%s)", frameCount, imageBytes, loadUs, atlas ? "atlas" : "loose images");
 
     skills = {
             {"Beam", "images/ui/icon_magic_beam", 2000,
-                [this](const pdcpp::Point<int>& position) { return std::make_unique<Beam>(position, weak_from_this()); }},
+                [](Player& player, const pdcpp::Point<int>& position) { player.magicLaunched.Launch<Beam>(position, &player); }},
             {"Projectile", "images/ui/icon_magic_projectile", 1500,
-                [this](const pdcpp::Point<int>& position) { return std::make_unique<Projectile>(position, weak_from_this()); }},
+                [](Player& player, const pdcpp::Point<int>& position) { player.magicLaunched.Launch<Projectile>(position, &player); }},
             {"Orbiting", "images/ui/icon_magic_orbiting_projectile", 5000,
-                [this](const pdcpp::Point<int>& position) { return std::make_unique<OrbitingProjectiles>(position, weak_from_this()); }},
+                [](Player& player, const pdcpp::Point<int>& position) { player.magicLaunched.Launch<OrbitingProjectiles>(position, &player); }},
             {"Rapid Shot", "images/ui/icon_magic_projectile", 800,
-                [this](const pdcpp::Point<int>& position) { return std::make_unique<Projectile>(position, weak_from_this(), 10.0f, 4, 500, 0.25f); }},
+                [](Player& player, const pdcpp::Point<int>& position) { player.magicLaunched.Launch<Projectile>(position, &player, 10.0f, 4, 500, 0.25f); }},
             {"Heavy Beam", "images/ui/icon_magic_beam", 3500,
-                [this](const pdcpp::Point<int>& position) { return std::make_unique<Beam>(position, weak_from_this(), 3, 200.0f, 500, 0.7f); }}
+                [](Player& player, const pdcpp::Point<int>& position) { player.magicLaunched.Launch<Beam>(position, &player, 3, 200.0f, 500, 0.7f); }}
     };
     lastSkillCastTimes.assign(skills.size(), pdcpp::GlobalPlaydateAPI::get()->system->getCurrentTimeMilliseconds());
 }
@@ -119,8 +98,7 @@ void Player::Tick(const std::shared_ptr<Area>& area)
     if (pendingCast && currentTime - pendingCastStartTime >= attackCastDelay)
     {
         // Spawn the magic projectile after the animation wind-up
-        std::unique_ptr<Magic> magic = skills[pendingCastMagicIndex].factory(GetCenteredPosition());
-        magicLaunched.push_back(std::move(magic));
+        skills[pendingCastMagicIndex].launch(*this, GetCenteredPosition());
         pendingCast = false;
     }
 
@@ -133,18 +111,7 @@ void Player::Tick(const std::shared_ptr<Area>& area)
         }
     }
 
-    for(auto& magic : magicLaunched)
-    {
-        if (!magic->IsAlive())
-        {
-            magic.reset();
-        }
-        else
-        {
-            magic->Update(area);
-        }
-    }
-    magicLaunched.erase(std::remove(magicLaunched.begin(), magicLaunched.end(), nullptr), magicLaunched.end());
+    magicLaunched.Update();
 }
 
 void Player::Move(int deltaX, int deltaY, const std::shared_ptr<Area>& area)
@@ -161,56 +128,61 @@ void Player::Move(int deltaX, int deltaY, const std::shared_ptr<Area>& area)
     }
     SetPosition(pdcpp::Point<int>(x, y));
 }
-void Player::Draw()
+void Player::SubmitDraw(DrawList& drawList)
 {
-    pdcpp::Point<int> drawPosition = GetPosition();
-    drawPosition.x -= 20;
-    drawPosition.y -= 35;
     if (CalculateFlashing())
     {
-        if (attacking)
-        {
-            attack->Draw(drawPosition);
-        }
-        else if (dx != 0 || dy != 0)
-        {
-            // Draw walking animation based on facing direction
-            switch (facingDirection)
-            {
-                case Direction::North:
-                    walkNorth->Draw(drawPosition);
-                    break;
-                case Direction::South:
-                    walkSouth->Draw(drawPosition);
-                    break;
-                case Direction::East:
-                case Direction::West:
-                    walkEast->Draw(drawPosition);
-                    break;
-                default:
-                    walkSouth->Draw(drawPosition);
-                    break;
-            }
-        }
-        else
-        {
-            idle->Draw(drawPosition);
-        }
+        drawList.SubmitEntity(DrawList::Layer::Sprites, DrawList::Type::EntityBody, GetDrawBaseline(), this);
     }
-    Entity::DrawHealthBar(Globals::HEALTH_BAR_OFFSET_X, Globals::HEALTH_BAR_OFFSET_Y - 30);
-    DrawAimDirection();
+    drawList.SubmitEntity(DrawList::Layer::Overlay, DrawList::Type::EntityOverlay, GetDrawBaseline(), this);
+    drawList.SubmitPlayerMagic(magicLaunched);
+}
+
+int Player::GetDrawBaseline() const
+{
+    // The sprite is drawn 35 pixels above the position and is PLAYER_SIZE tall
+    return GetPosition().y - 35 + Globals::PLAYER_SIZE;
 }
 
-void Player::DrawMagic() const
+void Player::DrawBody()
 {
-    // Draw all active magic projectiles on top of the map
-    for(const auto& magic : magicLaunched)
+    pdcpp::Point<int> drawPosition = GetPosition();
+    drawPosition.x -= 20;
+    drawPosition.y -= 35;
+    if (attacking)
     {
-        if (magic && magic->IsAlive())
+        attack->Draw(drawPosition);
+    }
+    else if (dx != 0 || dy != 0)
+    {
+        // Draw walking animation based on facing direction
+        switch (facingDirection)
         {
-            magic->Draw();
+            case Direction::North:
+                walkNorth->Draw(drawPosition);
+                break;
+            case Direction::South:
+                walkSouth->Draw(drawPosition);
+                break;
+            case Direction::East:
+            case Direction::West:
+                walkEast->Draw(drawPosition);
+                break;
+            default:
+                walkSouth->Draw(drawPosition);
+                break;
         }
     }
+    else
+    {
+        idle->Draw(drawPosition);
+    }
+}
+
+void Player::DrawOverlay() const
+{
+    Entity::DrawHealthBar(Globals::HEALTH_BAR_OFFSET_X, Globals::HEALTH_BAR_OFFSET_Y - 30);
+    DrawAimDirection();
 }
 void Player::HandleInput()
 {
@@ -304,6 +276,11 @@ void Player::HandleInput()
     {
         return;
     }
+    // The spell would be dropped, keep the cooldown ready for when a slot frees up
+    if (magicLaunched.IsFull())
+    {
+        return;
+    }
 
     // Trigger attack animation immediately, queue the magic cast for later
     attacking = true;
@@ -430,39 +407,24 @@ void Player::HandleAutoFire(const std::shared_ptr<Area>& area)
         return;
     }
 
-    // Find the closest enemy
-    auto creatures = area->GetCreatures();
-    if (creatures.empty())
+    // A cast winding up already paid its cooldown, leave it the last slot
+    if (pendingCast && magicLaunched.Size() + 1 >= Globals::PLAYER_MAGIC_CAPACITY)
     {
         return;
     }
 
-    std::shared_ptr<Monster> closestEnemy = nullptr;
-    float minDistance = std::numeric_limits<float>::max();
-    pdcpp::Point<int> playerPos = GetCenteredPosition();
+    // Find the closest enemy
+    MonsterStore& monsters = area->GetMonsterStore();
+    const int closestEnemy = monsters.FindNearest(GetCenteredPosition(), Globals::AUTO_FIRE_RANGE);
 
-    for (const auto& monster : creatures)
+    if (closestEnemy >= 0)
     {
-        if (!monster->IsAlive())
-        {
-            continue;
-        }
-
-        float distance = playerPos.distance(monster->GetCenteredPosition());
-        if (distance < minDistance)
+        // Launch auto-targeting projectile
+        if (magicLaunched.Launch<AutoProjectile>(GetCenteredPosition(), this, &monsters, monsters.GetHandle(closestEnemy)))
         {
-            minDistance = distance;
-            closestEnemy = monster;
+            lastAutoFireTime = currentTime;
         }
     }
-
-    if (closestEnemy && minDistance <= Globals::AUTO_FIRE_RANGE)
-    {
-        // Launch auto-targeting projectile
-        auto autoProjectile = std::make_unique<AutoProjectile>(GetCenteredPosition(), weak_from_this(), closestEnemy);
-        magicLaunched.push_back(std::move(autoProjectile));
-        lastAutoFireTime = currentTime;
-    }
 }
 
 bool Player::LevelUp()
@@ -5,12 +5,12 @@
 #include <string>
 #include "Creature.h"
 #include "AnimationClip.h"
-#include "Magic.h"
+#include "MagicStore.h"
 
 class EntityManager;
 class Area;
 
-class Player : public Creature, public std::enable_shared_from_this<Player>
+class Player : public Creature
 {
 public:
     enum class StatType
@@ -58,13 +58,13 @@ private:
     bool pendingCast = false;
     unsigned int pendingCastStartTime = 0;
     unsigned int pendingCastMagicIndex = 0;
-    std::vector<std::unique_ptr<Magic>> magicLaunched;
+    MagicStore magicLaunched;
     struct SkillDefinition
     {
         std::string name;
         std::string iconPath;
         unsigned int cooldownMs;
-        std::function<std::unique_ptr<Magic>(const pdcpp::Point<int>&)> factory;
+        void (*launch)(Player& player, const pdcpp::Point<int>& position); // constructs the magic in magicLaunched
     };
     std::vector<SkillDefinition> skills;
     std::vector<unsigned int> lastSkillCastTimes;
@@ -94,8 +94,11 @@ public:
     void Move(int deltaX, int deltaY, const std::shared_ptr<Area>& area);
     void HandleInput();
     void HandleAutoFire(const std::shared_ptr<Area>& area);
-    void Draw() override;
-    void DrawMagic() const;
+    void SubmitDraw(DrawList& drawList) override; // the player, its health bar, aim arrow and magic
+    void DrawBody() override;
+    void DrawOverlay() const override;
+    [[nodiscard]] int GetDrawBaseline() const override;
+    [[nodiscard]] MagicStore& GetLaunchedMagic() { return magicLaunched; }
     void DrawAimDirection() const;
     void Damage(float damage); // Override to capture final survival time
 
@@ -7,13 +7,13 @@
 #include "Log.h"
 #include "Monster.h"
 
-Projectile::Projectile(pdcpp::Point<int> Position, std::weak_ptr<Player> _player)
-    : Projectile(Position, std::move(_player), 8.0f, 6, 800, 0.5f)
+Projectile::Projectile(pdcpp::Point<int> Position, Player* _player)
+    : Projectile(Position, _player, 8.0f, 6, 800, 0.5f)
 {}
 
-Projectile::Projectile(pdcpp::Point<int> Position, std::weak_ptr<Player> _player,
+Projectile::Projectile(pdcpp::Point<int> Position, Player* _player,
                        float _speed, unsigned int _size, unsigned int _explosionThreshold, float _damage)
-    : Magic(Position, std::move(_player))
+    : Magic(Position, _player)
 {
     iLifetime = 2000;
     speed = _speed;
@@ -51,17 +51,14 @@ void Projectile::HandleInput()
     position.y += static_cast<int>(sin(launchAngle) * speed);
 }
 
-void Projectile::Damage(const std::shared_ptr<Area>& area)
+HitShape Projectile::GetHitShape() const
 {
-    auto projectileCenteredPos = GetCenteredPosition();
-    for (const auto& entity : area->GetCreatures())
-    {
-        float distance = projectileCenteredPos.distance(entity->GetPosition());
-        if (distance < static_cast<float>(size)/2.f)
-        {
-            entity->Damage(damagePerHit);
-        }
-    }
+    return HitShape::Circle(GetCenteredPosition(), static_cast<float>(size)/2.f);
+}
+
+void Projectile::OnHit(Monster& monster)
+{
+    monster.Damage(damagePerHit);
 }
 
 pdcpp::Point<int> Projectile::GetCenteredPosition() const
@@ -8,16 +8,17 @@
 #include "pdcpp/graphics/Point.h"
 #include "Magic.h"
 
-class Projectile : public Magic{
+class Projectile final : public Magic{
 public:
     Projectile() = delete;
-    explicit Projectile(pdcpp::Point<int> Position, std::weak_ptr<Player> player);
-    Projectile(pdcpp::Point<int> Position, std::weak_ptr<Player> player, float speed, unsigned int size, unsigned int explosionThreshold, float damage);
+    explicit Projectile(pdcpp::Point<int> Position, Player* player);
+    Projectile(pdcpp::Point<int> Position, Player* player, float speed, unsigned int size, unsigned int explosionThreshold, float damage);
     bool operator==(const Projectile& other) const {return this == &other;}
 
     void Draw() const override;
     void HandleInput() override;
-    void Damage(const std::shared_ptr<Area>& area) override;
+    [[nodiscard]] HitShape GetHitShape() const override;
+    void OnHit(Monster& monster) override;
     pdcpp::Point<int> GetCenteredPosition() const;
 
 private:
@@ -26,7 +27,7 @@ private:
     unsigned int size;
     unsigned int explosionThreshold;
     float launchAngle = 0.0f; // Angle in radians
-    const int sizeIncrement = 3; // Increment size when exploding
+    static constexpr int sizeIncrement = 3; // Increment size when exploding
     float damagePerHit = 0.5f;
 };
 
@@ -465,12 +465,11 @@ bool SaveGame::DeserializeMonsters(const std::shared_ptr<Area>& area, const char
             continue;
         }
 
-        // Create a copy of the monster template
-        auto restoredMonster = std::make_shared<Monster>(*monsterTemplate);
+        // Create a copy of the monster template, with its bitmap already set
+        auto restoredMonster = area->CreateMonster(*monsterTemplate);
 
         // Restore saved state
         restoredMonster->SetHP(monsterHp);
-        restoredMonster->LoadBitmap();
         restoredMonster->SetPosition(pdcpp::Point<int>(posX, posY));
 
         // Add to living monsters
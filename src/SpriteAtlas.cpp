@@ -0,0 +1,161 @@
+#include "SpriteAtlas.h"
+#include "Log.h"
+#include "Utils.h"
+#include "jsmn.h"
+#include "pdcpp/core/File.h"
+#include "pdcpp/core/GlobalPlaydateAPI.h"
+#include "pdcpp/graphics/Graphics.h"
+#include <algorithm>
+
+std::unordered_map<std::string, std::unique_ptr<SpriteAtlas>> SpriteAtlas::cache;
+
+SpriteAtlas::~SpriteAtlas()
+{
+    for (LCDBitmap* bitmap : bitmaps)
+    {
+        pdcpp::GlobalPlaydateAPI::get()->graphics->freeBitmap(bitmap);
+    }
+}
+
+const SpriteAtlas* SpriteAtlas::Get(const std::string& path)
+{
+    auto it = cache.find(path);
+    if (it != cache.end()) return it->second.get();
+
+    std::unique_ptr<SpriteAtlas> atlas(new SpriteAtlas());
+    if (!atlas->Load(path)) atlas.reset();
+    return cache.emplace(path, std::move(atlas)).first->second.get();
+}
+
+bool SpriteAtlas::Load(const std::string& path)
+{
+    const std::string metadataPath = path + ".json";
+    if (!pdcpp::FileHelpers::fileExists(metadataPath))
+    {
+        Log::Info("No atlas at %s, using loose images", path.c_str());
+        return false;
+    }
+
+    auto fileHandle = std::make_unique<pdcpp::FileHandle>(metadataPath, kFileRead);
+    const size_t size = fileHandle->getDetails().size;
+    auto buffer = std::make_unique<char[]>(size + 1);
+    fileHandle->read(buffer.get(), size);
+
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    const int tokenCount = jsmn_parse(&parser, buffer.get(), size, nullptr, 0);
+    if (tokenCount <= 0)
+    {
+        Log::Error("Atlas %s has a broken frame list: %d", metadataPath.c_str(), tokenCount);
+        return false;
+    }
+    std::vector<jsmntok_t> tokens(tokenCount);
+    jsmn_init(&parser);
+    Utils::InitializeJSMN(&parser, buffer.get(), size, tokenCount, tokens.data());
+
+    // One flat object per frame: {"clip", "x", "y", "w", "h", "ox", "oy", "sw", "sh"}
+    for (int i = 0; i < tokenCount; i++)
+    {
+        if (tokens[i].type != JSMN_OBJECT) continue;
+        const int end = i + (tokens[i].size * 2);
+        auto field = [&](const char* property) { return static_cast<short>(std::stoi(Utils::ValueDecoder(buffer.get(), tokens.data(), i, end, property))); };
+
+        const std::string clip = Utils::ValueDecoder(buffer.get(), tokens.data(), i, end, "clip");
+        if (clips.empty() || clips.back().first != clip)
+        {
+            clips.push_back({clip, {static_cast<int>(frames.size()), 0}});
+        }
+        clips.back().second.count++;
+        frames.push_back({field("x"), field("y"), field("w"), field("h"), field("ox"), field("oy"), field("sw"), field("sh")});
+        i = end;
+    }
+    std::sort(clips.begin(), clips.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (frames.empty()) return false;
+
+    const char* outErr = nullptr;
+    auto* graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    LCDBitmap* atlas = graphics->loadBitmap(path.c_str(), &outErr);
+    if (atlas == nullptr)
+    {
+        Log::Error("Couldn't load atlas bitmap %s: %s", path.c_str(), outErr);
+        return false;
+    }
+    const bool cut = CutFrames(atlas);
+    graphics->freeBitmap(atlas);
+    if (!cut) return false;
+
+    Log::Info("Loaded atlas %s: %d frames, %d clips, %d bitmaps", path.c_str(), GetFrameCount(), static_cast<int>(clips.size()), static_cast<int>(bitmaps.size()));
+    return true;
+}
+
+bool SpriteAtlas::CutFrames(LCDBitmap* atlas)
+{
+    auto* graphics = pdcpp::GlobalPlaydateAPI::get()->graphics;
+    frameBitmaps.reserve(frames.size());
+    std::unordered_map<int, LCDBitmap*> cut; // by atlas position, pack-atlas.py gives identical frames the same rectangle
+    for (const Frame& frame : frames)
+    {
+        const int key = (frame.y << 16) | frame.x;
+        auto it = cut.find(key);
+        if (it != cut.end())
+        {
+            frameBitmaps.push_back(it->second);
+            continue;
+        }
+
+        LCDBitmap* bitmap = graphics->newBitmap(frame.width, frame.height, kColorClear);
+        if (bitmap == nullptr)
+        {
+            Log::Error("Couldn't allocate a %dx%d atlas frame", static_cast<int>(frame.width), static_cast<int>(frame.height));
+            return false;
+        }
+        {
+            pdcpp::Graphics::ScopedGraphicsContext context(bitmap);
+            graphics->drawBitmap(atlas, -frame.x, -frame.y, kBitmapUnflipped);
+        }
+        bitmaps.push_back(bitmap);
+        frameBitmaps.push_back(bitmap);
+        cut.emplace(key, bitmap);
+    }
+    return true;
+}
+
+SpriteAtlas::Clip SpriteAtlas::FindClip(const std::string& name) const
+{
+    std::string key = name;
+    if (key.size() > 4 && key.compare(key.size() - 4, 4, ".png") == 0) key.resize(key.size() - 4);
+
+    auto it = std::lower_bound(clips.begin(), clips.end(), key, [](const auto& entry, const std::string& value) { return entry.first < value; });
+    if (it == clips.end() || it->first != key) return {};
+    return it->second;
+}
+
+void SpriteAtlas::DrawFrame(const int index, const int x, const int y, const LCDBitmapFlip flip) const
+{
+    const Frame& frame = frames[index];
+    // The trimmed frame mirrors inside the original one, so its offset flips too
+    const int left = x + (flip == kBitmapFlippedX ? frame.sourceWidth - frame.offsetX - frame.width : frame.offsetX);
+    pdcpp::GlobalPlaydateAPI::get()->graphics->drawBitmap(frameBitmaps[index], left, y + frame.offsetY, flip);
+}
+
+int SpriteAtlas::GetMemoryBytes() const
+{
+    int bytes = 0;
+    for (LCDBitmap* bitmap : bitmaps)
+    {
+        bytes += GetBitmapBytes(bitmap);
+    }
+    return bytes;
+}
+
+int SpriteAtlas::GetBitmapBytes(LCDBitmap* bitmap)
+{
+    if (bitmap == nullptr) return 0;
+    int bitmapWidth = 0;
+    int bitmapHeight = 0;
+    int rowBytes = 0;
+    uint8_t* mask = nullptr;
+    uint8_t* data = nullptr;
+    pdcpp::GlobalPlaydateAPI::get()->graphics->getBitmapData(bitmap, &bitmapWidth, &bitmapHeight, &rowBytes, &mask, &data);
+    return rowBytes * bitmapHeight * (mask ? 2 : 1);
+}
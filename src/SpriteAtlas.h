@@ -0,0 +1,82 @@
+#ifndef CARDOBLAST_SPRITEATLAS_H
+#define CARDOBLAST_SPRITEATLAS_H
+
+#include "pd_api.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief The sprites of a character, loaded from one packed image.
+ *
+ * Python-tools/pack-atlas.py trims the transparent border of every frame, packs the frames
+ * of a character into a single image and writes a .json list of them next to it. Each entry
+ * names its clip (the folder the frame came from, or the sprite path) and gives the frame's
+ * rectangle in the atlas, its offset inside the original frame and the original size.
+ * Frames of a clip are contiguous and in order.
+ *
+ * Loading a character is then two file opens instead of one per frame. The frames are not
+ * drawn from the shared atlas though: that needs a clip rect around each draw, and the
+ * Playdate API can't read back the clip of the caller (the dirty region redraws) to restore
+ * it. Load cuts every trimmed frame into a bitmap of its own instead (identical frames share
+ * one) and frees the atlas, so drawing a frame is a plain drawBitmap.
+ *
+ * The cost is memory: every frame bitmap carries its own header and row padding on top of the
+ * trimmed pixels, where one atlas would carry them once, and Load holds the atlas and the cut
+ * frames together until it frees the atlas. GetMemoryBytes reports the bytes kept.
+ */
+class SpriteAtlas
+{
+public:
+    struct Frame
+    {
+        short x, y, width, height;         // rectangle in the atlas
+        short offsetX, offsetY;            // top left of the trimmed frame inside the original one
+        short sourceWidth, sourceHeight;   // size of the original frame
+    };
+
+    struct Clip
+    {
+        int first = 0;
+        int count = 0;
+        [[nodiscard]] bool IsValid() const { return count > 0; }
+    };
+
+    ~SpriteAtlas();
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+    /**
+     * @brief The atlas at `path` (without extension), loaded on the first call.
+     * @return nullptr if the atlas or its frame list isn't there, the caller loads loose images then
+     */
+    static const SpriteAtlas* Get(const std::string& path);
+
+    // Frames of the clip, invalid if the atlas doesn't have it. A ".png" extension is ignored.
+    [[nodiscard]] Clip FindClip(const std::string& name) const;
+    [[nodiscard]] const Frame& GetFrame(int index) const { return frames[index]; }
+    [[nodiscard]] int GetFrameCount() const { return static_cast<int>(frames.size()); }
+    // Bytes of pixel and mask data of the frame bitmaps
+    [[nodiscard]] int GetMemoryBytes() const;
+
+    // Draw the frame with the top left corner of its original, untrimmed size at x, y
+    void DrawFrame(int index, int x, int y, LCDBitmapFlip flip) const;
+
+    static int GetBitmapBytes(LCDBitmap* bitmap);
+
+private:
+    SpriteAtlas() = default;
+    bool Load(const std::string& path);
+    bool CutFrames(LCDBitmap* atlas);
+
+    std::vector<Frame> frames;
+    std::vector<LCDBitmap*> frameBitmaps; // per frame, shared by identical frames
+    std::vector<LCDBitmap*> bitmaps; // each distinct frame bitmap once, owned
+    std::vector<std::pair<std::string, Clip>> clips; // sorted by name
+
+    // nullptr for the atlases that failed, so they're only tried once
+    static std::unordered_map<std::string, std::unique_ptr<SpriteAtlas>> cache;
+};
+
+#endif //CARDOBLAST_SPRITEATLAS_H
@@ -57,7 +57,87 @@ UI::UI(const char *fontPath, EntityManager* manager)
 void UI::Update()
 {
     HandleInputs();
-    Draw();
+    animationFrame++;
+}
+
+void UI::CollectDirtyRegions(DirtyRegions& regions)
+{
+    using namespace UIConstants;
+    const int maxScore = maxScorePtr ? *maxScorePtr : 0;
+    const std::shared_ptr<Player> player = entityManager->GetPlayer();
+
+    if (!hasDrawn || currentScreen != drawnScreen)
+    {
+        regions.MarkAll();
+    }
+    else if (currentScreen == GameScreen::LOADING)
+    {
+        if (loadingProgress != drawnProgress)
+        {
+            regions.MarkDirty({Loading::PROGRESS_BAR_X, Loading::PROGRESS_BAR_Y, Loading::PROGRESS_BAR_WIDTH, Loading::PROGRESS_BAR_HEIGHT});
+        }
+        if (GetLoadingTextPhase() != drawnLoadingTextPhase)
+        {
+            regions.MarkDirty({0, Loading::TEXT_Y, SCREEN_WIDTH, font.getFontHeight()});
+        }
+    }
+    else if (currentScreen == GameScreen::MAIN_MENU)
+    {
+        if (selectedMenuItem != drawnMenuItem)
+        {
+            regions.MarkDirty({MainMenu::MENU_ITEM_X, MainMenu::MENU_START_Y, MainMenu::MENU_ITEM_WIDTH,
+                               (menuItemCount - 1) * MainMenu::MENU_ITEM_SPACING + MainMenu::MENU_ITEM_HEIGHT});
+        }
+        if (maxScore != drawnMaxScore)
+        {
+            // "Max\nLocal\nKills:\n<score>"
+            regions.MarkDirty({MainMenu::MAX_LOCAL_SCORE_X, MainMenu::MAX_LOCAL_SCORE_Y, SCREEN_WIDTH, 4 * font.getFontHeight()});
+        }
+    }
+    else if (currentScreen == GameScreen::GAME && player && offset == drawnOffset && !showLevelUpPopup && !drawnLevelUpPopup)
+    {
+        // The HUD is drawn around the camera center, which is the center of the screen
+        const int centerX = SCREEN_WIDTH / 2;
+        const int centerY = SCREEN_HEIGHT / 2;
+        if (player->GetTiledPosition() != drawnPlayerTile)
+        {
+            const int coordsX = centerX + GameHUD::COORDS_X_OFFSET;
+            regions.MarkDirty({coordsX, centerY + GameHUD::COORDS_Y_OFFSET_Y, SCREEN_WIDTH - coordsX, font.getFontHeight()});
+        }
+        if (player->GetCooldownPercentage() != drawnCooldown)
+        {
+            regions.MarkDirty({centerX - GameHUD::COOLDOWN_RADIUS - 1, centerY + GameHUD::MAGIC_COOLDOWN_Y_OFFSET - GameHUD::COOLDOWN_RADIUS - 1,
+                               2 * GameHUD::COOLDOWN_RADIUS + 2, 2 * GameHUD::COOLDOWN_RADIUS + 2});
+        }
+        if (player->GetSelectedMagic() != drawnSelectedMagic || player->GetSkillCount() != drawnSkillCount)
+        {
+            // The three icons, each no wider than the spacing between them, down to the bottom of the screen
+            const int iconSpacing = GameHUD::MAGIC_ICON_RIGHT_X_OFFSET - GameHUD::MAGIC_ICON_CENTER_X_OFFSET;
+            const int iconsX = centerX + GameHUD::MAGIC_ICON_LEFT_X_OFFSET;
+            const int iconsY = centerY + GameHUD::MAGIC_ICON_CENTER_Y_OFFSET;
+            regions.MarkDirty({iconsX, iconsY, GameHUD::MAGIC_ICON_RIGHT_X_OFFSET - GameHUD::MAGIC_ICON_LEFT_X_OFFSET + iconSpacing, SCREEN_HEIGHT - iconsY});
+        }
+    }
+    else
+    {
+        regions.MarkAll();
+    }
+
+    hasDrawn = true;
+    drawnScreen = currentScreen;
+    drawnProgress = loadingProgress;
+    drawnLoadingTextPhase = GetLoadingTextPhase();
+    drawnMenuItem = selectedMenuItem;
+    drawnMaxScore = maxScore;
+    drawnOffset = offset;
+    drawnLevelUpPopup = showLevelUpPopup;
+    if (player)
+    {
+        drawnPlayerTile = player->GetTiledPosition();
+        drawnCooldown = player->GetCooldownPercentage();
+        drawnSelectedMagic = player->GetSelectedMagic();
+        drawnSkillCount = player->GetSkillCount();
+    }
 }
 
 void UI::HandleInputs()
@@ -255,6 +335,13 @@ void UI::Draw() const
     }
 }
 
+int UI::GetLoadingTextPhase() const
+{
+    // Three "Loading" frames while loading, then four "Press any button" frames
+    const int step = animationFrame / UIConstants::Loading::ANIMATION_FRAME_DELAY;
+    return loadingProgress < 1.0f ? step % 3 : 3 + step % 4;
+}
+
 void UI::DrawLoadingScreen() const
 {
     using namespace UIConstants;
@@ -294,9 +381,8 @@ void UI::DrawLoadingScreen() const
     pdcpp::Graphics::fillRectangle(progressBar, pdcpp::Colors::white);
 
     // Animated loading text using Font::drawWrappedText
-    static int frameCount = 0;
     std::string loadingText;
-    frameCount++;
+    const int textPhase = GetLoadingTextPhase();
 
     // Create text bounds for centered text
     pdcpp::Rectangle<float> textBounds(
@@ -307,7 +393,7 @@ void UI::DrawLoadingScreen() const
     if (loadingProgress < 1.0f)
     {
         // Simple dots animation
-        switch ((frameCount / Loading::ANIMATION_FRAME_DELAY) % 3)
+        switch (textPhase)
         {
             case 0: loadingText = "Loading."; break;
             case 1: loadingText = "Loading.."; break;
@@ -328,12 +414,12 @@ void UI::DrawLoadingScreen() const
     else
     {
         // Blinking "press button" message
-        switch ((frameCount / Loading::ANIMATION_FRAME_DELAY) % 4)
+        switch (textPhase)
         {
-            case 0: loadingText = "Press any button to continue."; break;
-            case 1: loadingText = "Press any button to continue.."; break;
-            case 2: loadingText = "Press any button to continue..."; break;
-            case 3:
+            case 3: loadingText = "Press any button to continue."; break;
+            case 4: loadingText = "Press any button to continue.."; break;
+            case 5: loadingText = "Press any button to continue..."; break;
+            case 6:
             default: loadingText = ""; break;
         }
 
@@ -13,6 +13,7 @@
 #include "pdcpp/graphics/Point.h"
 #include "pdcpp/graphics/Font.h"
 #include "CircularProgress.h"
+#include "DirtyRegions.h"
 #include "Player.h"
 #include "UIConstants.h"
 #include "pdcpp/core/GlobalPlaydateAPI.h"
@@ -38,6 +39,21 @@ private:
     pdcpp::Font font;  // Changed from LCDFont* to pdcpp::Font
     pdcpp::Point<int> offset = {0,0};
     std::unique_ptr<CircularProgress> magicCooldown;
+    int animationFrame = 0; // frames since start, drives the loading text animation
+
+    // What the static screens showed when they were last drawn, to find the regions that changed
+    bool hasDrawn = false;
+    GameScreen drawnScreen = GameScreen::LOADING;
+    float drawnProgress = 0.0f;
+    int drawnLoadingTextPhase = 0;
+    int drawnMenuItem = 0;
+    int drawnMaxScore = 0;
+    pdcpp::Point<int> drawnOffset = {0,0};
+    bool drawnLevelUpPopup = false;
+    pdcpp::Point<int> drawnPlayerTile = {0,0};
+    float drawnCooldown = 0.0f;
+    unsigned int drawnSelectedMagic = 0;
+    size_t drawnSkillCount = 0;
 
     PDMenuItem* saveMenuItem = nullptr;
     PDMenuItem* statsMenuItem = nullptr;
@@ -62,8 +78,18 @@ private:
 
 public:
     explicit UI(const char* fontPath, EntityManager* manager);
+    // Handles the inputs and advances the animations. Drawing is separate, see Draw.
     void Update();
     void Draw() const;
+    /**
+     * @brief Mark the screen regions whose content changed since the last call.
+     *
+     * Menu and loading screens mark only what changed (progress bar, animated text, selection).
+     * The game screen marks the HUD elements whose value changed (coordinates, cooldown gauge,
+     * magic icons), and the whole screen when the HUD moved (camera or shake) or the level-up
+     * popup is up. The game over screen always marks the whole screen.
+     */
+    void CollectDirtyRegions(DirtyRegions& regions);
     void HandleInputs();
     void SwitchScreen(GameScreen newScreen);
     void SetMaxScorePointer(int* scorePtr) { maxScorePtr = scorePtr; }
@@ -82,6 +108,7 @@ public:
 
 private:
     int* maxScorePtr = nullptr;
+    [[nodiscard]] int GetLoadingTextPhase() const;
     void DrawLoadingScreen() const;
     void DrawMainMenu() const;
     void DrawGameScreen() const;